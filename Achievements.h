@@ -19,6 +19,8 @@
 #include "Containers.h"
 #include "CXStr.h"
 
+#include <vector>
+
 namespace eqlib {
 
 class CSerializeBuffer;
@@ -400,6 +402,21 @@ public:
 		SingleAchievementAndComponentsInfoWithCounts& outInfo,
 		int achievementIndex) const;
 
+	// Returns the count of the component at |componentIndex| in the given achievement. Backed by
+	// the same cached snapshot as FillAchievementComponentInfoWithCounts.
+	EQLIB_OBJECT int GetAchievementComponentCount(int achievementIndex, AchievementComponentType type,
+		int componentIndex) const;
+
+	// Returns the indices of the child categories of the category at |categoryIndex|. The
+	// returned list is only valid until the achievement data changes.
+	EQLIB_OBJECT const std::vector<int>& GetChildCategoryIndices(int categoryIndex) const;
+
+	// Lookups by name, the category tree and component counts are served from an index that is
+	// built on first use. The name and category indices are rebuilt when the achievement data is
+	// reloaded, and component counts are refreshed when achievement states change. Call this to
+	// force both to be rebuilt, e.g. after receiving a component progress update.
+	EQLIB_OBJECT void InvalidateAchievementIndex() const;
+
 	//----------------------------------------------------------------------------
 	// AchievementManager
 
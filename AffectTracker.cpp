@@ -0,0 +1,297 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "AffectTracker.h"
+
+#include "EQLib.h"
+
+namespace eqlib {
+
+static bool IsSpellSlotOccupied(const EQ_Affect& affect)
+{
+	return affect.SpellID > 0;
+}
+
+// True if the effect was recast (or replaced by the same spell from someone else) rather than
+// just ticking down.
+static bool IsAffectRefreshed(const EQ_Affect& previous, const EQ_Affect& current)
+{
+	return current.Duration > previous.Duration
+		|| current.InitialDuration != previous.InitialDuration
+		|| memcmp(&current.CasterGuid, &previous.CasterGuid, sizeof(current.CasterGuid)) != 0;
+}
+
+static bool HaveAffectCountersChanged(const EQ_Affect& previous, const EQ_Affect& current)
+{
+	// Compared by field, SlotData has padding between Slot and Value.
+	for (int i = 0; i < NUM_SLOTDATA; ++i)
+	{
+		if (current.SlotData[i].Slot != previous.SlotData[i].Slot
+			|| current.SlotData[i].Value != previous.SlotData[i].Value)
+		{
+			return true;
+		}
+	}
+
+	return current.HitCount != previous.HitCount
+		|| current.ChargesRemaining != previous.ChargesRemaining;
+}
+
+AffectTracker::AffectTracker()
+{
+}
+
+int AffectTracker::Subscribe(Callback callback)
+{
+	int id = m_nextSubscriptionId++;
+
+	// Subscribers added by a callback start with the next Update.
+	if (m_notifying)
+		m_pendingSubscriptions.push_back(Subscription{ id, std::move(callback) });
+	else
+		m_subscriptions.push_back(Subscription{ id, std::move(callback) });
+
+	return id;
+}
+
+void AffectTracker::Unsubscribe(int subscriptionId)
+{
+	auto matches = [subscriptionId](const Subscription& s) { return s.id == subscriptionId; };
+
+	m_pendingSubscriptions.erase(std::remove_if(m_pendingSubscriptions.begin(), m_pendingSubscriptions.end(), matches),
+		m_pendingSubscriptions.end());
+
+	if (m_notifying)
+	{
+		// The list is being walked, so only mark it. It is removed once the walk is done.
+		auto iter = std::find_if(m_subscriptions.begin(), m_subscriptions.end(), matches);
+		if (iter != m_subscriptions.end())
+			iter->id = 0;
+	}
+	else
+	{
+		m_subscriptions.erase(std::remove_if(m_subscriptions.begin(), m_subscriptions.end(), matches), m_subscriptions.end());
+	}
+}
+
+void AffectTracker::Reset()
+{
+	// Can't drop the events while they're being delivered, it happens when they're done.
+	if (m_notifying)
+	{
+		m_resetPending = true;
+		return;
+	}
+
+	m_snapshot.clear();
+	m_changes.clear();
+	m_slotsBySpell.clear();
+	m_slotsBySPA.clear();
+	m_slotSPAs.clear();
+}
+
+void AffectTracker::Notify()
+{
+	m_notifying = true;
+
+	// Indexes rather than iterators: nothing is added to or removed from either list until the
+	// walk is done, but callbacks may mark subscriptions as removed.
+	for (size_t change = 0; change < m_changes.size(); ++change)
+	{
+		for (size_t index = 0; index < m_subscriptions.size(); ++index)
+		{
+			if (m_subscriptions[index].id != 0)
+				m_subscriptions[index].callback(m_changes[change]);
+		}
+	}
+
+	m_notifying = false;
+
+	m_subscriptions.erase(std::remove_if(m_subscriptions.begin(), m_subscriptions.end(),
+		[](const Subscription& s) { return s.id == 0; }), m_subscriptions.end());
+
+	for (Subscription& subscription : m_pendingSubscriptions)
+		m_subscriptions.push_back(std::move(subscription));
+	m_pendingSubscriptions.clear();
+
+	if (m_resetPending)
+	{
+		m_resetPending = false;
+		Reset();
+	}
+}
+
+void AffectTracker::Publish(AffectChangeType type, int slot, int spellId)
+{
+	m_changes.push_back(AffectChangeEvent{ type, slot, spellId });
+}
+
+void AffectTracker::AddToIndex(int slot, int spellId)
+{
+	std::vector<int>& slots = m_slotsBySpell[spellId];
+	slots.insert(std::lower_bound(slots.begin(), slots.end(), slot), slot);
+
+	std::vector<int>& spas = m_slotSPAs[slot];
+	spas.clear();
+
+	if (pSpellMgr)
+	{
+		if (EQ_Spell* pSpell = pSpellMgr->GetSpellByID(spellId))
+		{
+			for (int i = 0; i < pSpell->GetNumEffects(); ++i)
+			{
+				int spa = pSpell->GetEffectAttrib(i);
+
+				// A spell can have the same SPA more than once, index the slot only once.
+				if (std::find(spas.begin(), spas.end(), spa) == spas.end())
+				{
+					spas.push_back(spa);
+					m_slotsBySPA[spa].push_back(slot);
+				}
+			}
+		}
+	}
+}
+
+void AffectTracker::RemoveFromIndex(int slot, int spellId)
+{
+	auto iter = m_slotsBySpell.find(spellId);
+	if (iter != m_slotsBySpell.end())
+	{
+		std::vector<int>& slots = iter->second;
+		slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+
+		if (slots.empty())
+			m_slotsBySpell.erase(iter);
+	}
+
+	for (int spa : m_slotSPAs[slot])
+	{
+		auto spaIter = m_slotsBySPA.find(spa);
+		if (spaIter != m_slotsBySPA.end())
+		{
+			std::vector<int>& slots = spaIter->second;
+			slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+
+			if (slots.empty())
+				m_slotsBySPA.erase(spaIter);
+		}
+	}
+
+	m_slotSPAs[slot].clear();
+}
+
+int AffectTracker::Update(const BaseProfile& profile)
+{
+	// A callback can't update the tracker while it's delivering the events of this update.
+	if (m_notifying)
+		return 0;
+
+	m_changes.clear();
+
+	int numSlots = profile.GetMaxEffects();
+	const EQ_Affect* current = numSlots > 0 ? &profile.GetEffect(0) : nullptr;
+
+	int previousSlots = static_cast<int>(m_snapshot.size());
+	if (numSlots > previousSlots)
+	{
+		// New slots start out empty, so anything in them is reported as added.
+		EQ_Affect empty;
+		empty.SpellID = 0;
+
+		m_snapshot.resize(numSlots, empty);
+		m_slotSPAs.resize(numSlots);
+	}
+
+	for (int slot = 0; slot < static_cast<int>(m_snapshot.size()); ++slot)
+	{
+		EQ_Affect& previous = m_snapshot[slot];
+
+		// The array shrank: whatever was in the slots that went away is gone.
+		if (slot >= numSlots)
+		{
+			if (IsSpellSlotOccupied(previous))
+			{
+				RemoveFromIndex(slot, previous.SpellID);
+				Publish(AffectChangeType::Removed, slot, previous.SpellID);
+			}
+
+			continue;
+		}
+
+		// Most slots don't change from one frame to the next. A straight memcmp over the
+		// record is vectorized by the CRT, so that's the only cost for them.
+		if (memcmp(&previous, &current[slot], sizeof(EQ_Affect)) == 0)
+			continue;
+
+		const EQ_Affect& now = current[slot];
+		bool wasOccupied = IsSpellSlotOccupied(previous);
+		bool isOccupied = IsSpellSlotOccupied(now);
+
+		if (wasOccupied && (!isOccupied || previous.SpellID != now.SpellID))
+		{
+			RemoveFromIndex(slot, previous.SpellID);
+			Publish(AffectChangeType::Removed, slot, previous.SpellID);
+		}
+
+		if (isOccupied && (!wasOccupied || previous.SpellID != now.SpellID))
+		{
+			AddToIndex(slot, now.SpellID);
+			Publish(AffectChangeType::Added, slot, now.SpellID);
+		}
+		else if (isOccupied)
+		{
+			if (IsAffectRefreshed(previous, now))
+				Publish(AffectChangeType::Refreshed, slot, now.SpellID);
+			else if (HaveAffectCountersChanged(previous, now))
+				Publish(AffectChangeType::CountersChanged, slot, now.SpellID);
+		}
+
+		memcpy(&previous, &now, sizeof(EQ_Affect));
+	}
+
+	if (numSlots < previousSlots)
+	{
+		m_snapshot.resize(numSlots);
+		m_slotSPAs.resize(numSlots);
+	}
+
+	int numChanges = static_cast<int>(m_changes.size());
+	Notify();
+
+	return numChanges;
+}
+
+int AffectTracker::GetSlotForSpell(int spellId) const
+{
+	auto iter = m_slotsBySpell.find(spellId);
+	if (iter == m_slotsBySpell.end() || iter->second.empty())
+		return -1;
+
+	return iter->second.front();
+}
+
+const std::vector<int>& AffectTracker::GetSlotsWithSPA(int spa) const
+{
+	static const std::vector<int> s_noSlots;
+
+	auto iter = m_slotsBySPA.find(spa);
+	if (iter == m_slotsBySPA.end())
+		return s_noSlots;
+
+	return iter->second;
+}
+
+} // namespace eqlib
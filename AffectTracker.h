@@ -0,0 +1,114 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Spells.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+class BaseProfile;
+
+enum class AffectChangeType : uint8_t
+{
+	Added,               // a spell appeared in a slot
+	Removed,             // a spell left a slot
+	Refreshed,           // same spell, but recast: duration went up or the caster changed
+	CountersChanged,     // same spell, but its slot data, hit count or charges changed
+};
+
+struct AffectChangeEvent
+{
+	AffectChangeType type;
+	int              slot;
+	int              spellId;
+};
+
+// Tracks changes to a profile's effects (buffs) between frames.
+//
+// Every Update takes a copy of the effect array and compares it with the one from the previous
+// Update. Only slots whose bytes differ are looked at further, and each of those produces the
+// events that describe the change. A slot whose duration simply ticked down doesn't produce an
+// event.
+//
+// The tracker also keeps a spell id -> slot index and an SPA -> slots index up to date, so
+// "do I have this spell" and "what's giving me this effect" don't need a scan either.
+class AffectTracker
+{
+public:
+	using Callback = std::function<void(const AffectChangeEvent&)>;
+
+	EQLIB_OBJECT AffectTracker();
+
+	// Diffs the effects of |profile| against the previous call, and notifies subscribers. Returns
+	// the number of events. Passing a different profile than last time reports everything that
+	// differs between the two.
+	EQLIB_OBJECT int Update(const BaseProfile& profile);
+
+	// Forgets the previous snapshot. The next Update reports every occupied slot as added.
+	EQLIB_OBJECT void Reset();
+
+	// Events produced by the last Update.
+	const std::vector<AffectChangeEvent>& GetChanges() const { return m_changes; }
+
+	// Subscribers are called for every event, in slot order, during Update. Callbacks may
+	// subscribe, unsubscribe and reset: new subscribers get events from the next Update, and a
+	// reset happens after the remaining events are delivered. Calling Update from a callback does
+	// nothing.
+	EQLIB_OBJECT int Subscribe(Callback callback);
+	EQLIB_OBJECT void Unsubscribe(int subscriptionId);
+
+	// Returns the lowest slot holding |spellId|, or -1.
+	EQLIB_OBJECT int GetSlotForSpell(int spellId) const;
+
+	// Returns the slots holding a spell with the given SPA, in no particular order.
+	EQLIB_OBJECT const std::vector<int>& GetSlotsWithSPA(int spa) const;
+
+	// The snapshot from the last Update.
+	int GetSlotCount() const { return static_cast<int>(m_snapshot.size()); }
+	const EQ_Affect* GetSnapshot(int slot) const
+	{
+		return slot >= 0 && slot < static_cast<int>(m_snapshot.size()) ? &m_snapshot[slot] : nullptr;
+	}
+
+private:
+	void AddToIndex(int slot, int spellId);
+	void RemoveFromIndex(int slot, int spellId);
+	void Publish(AffectChangeType type, int slot, int spellId);
+	void Notify();
+
+	std::vector<EQ_Affect> m_snapshot;
+	std::vector<AffectChangeEvent> m_changes;
+
+	std::unordered_map<int, std::vector<int>> m_slotsBySpell;   // sorted slots
+	std::unordered_map<int, std::vector<int>> m_slotsBySPA;
+	std::vector<std::vector<int>> m_slotSPAs;                   // SPAs indexed for each slot
+
+	struct Subscription
+	{
+		int id;
+		Callback callback;
+	};
+	std::vector<Subscription> m_subscriptions;                  // id 0 if removed during Notify
+	std::vector<Subscription> m_pendingSubscriptions;           // added during Notify
+	int m_nextSubscriptionId = 1;
+	bool m_notifying = false;
+	bool m_resetPending = false;
+};
+
+} // namespace eqlib
@@ -0,0 +1,104 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "AggroSnapshot.h"
+
+namespace eqlib {
+
+static uint32_t GetEntrySpawnId(int entry, const AggroMeterManagerClient& aggro, const CGroup* group,
+	const ExtendedTargetList* xtargets)
+{
+	if (entry == AD_Player)
+		return aggro.AggroTargetID;
+
+	if (entry == AD_Secondary)
+		return aggro.AggroSecondaryID;
+
+	if (entry >= AD_Group1 && entry <= AD_Group5)
+	{
+		// The group entries are the other members, slot 0 is us.
+		CGroupMember* member = group ? group->GetGroupMember(entry - AD_Group1 + 1) : nullptr;
+		return member && member->pPlayer ? member->pPlayer->SpawnID : 0;
+	}
+
+	if (entry >= AD_xTarget1 && entry <= AD_xTarget20 && xtargets)
+	{
+		int slot = entry - AD_xTarget1;
+		return slot < xtargets->GetNumSlots() ? xtargets->cbegin()[slot].SpawnID : 0;
+	}
+
+	return 0;
+}
+
+bool AggroMeterSnapshot::Capture(const AggroMeterManagerClient& aggro, const CGroup* group,
+	const ExtendedTargetList* xtargets)
+{
+	uint32_t changed = 0;
+
+	for (int entry = 0; entry < Capacity; ++entry)
+	{
+		uint16_t percent = aggro.aggroData[entry].AggroPct;
+		uint32_t spawnId = GetEntrySpawnId(entry, aggro, group, xtargets);
+
+		if (percent != percents[entry] || spawnId != spawnIds[entry])
+		{
+			percents[entry] = percent;
+			spawnIds[entry] = spawnId;
+			changed |= 1u << entry;
+		}
+	}
+
+	idsChanged = aggro.AggroLockID != lockId || aggro.AggroTargetID != targetId || aggro.AggroSecondaryID != secondaryId;
+	lockId = aggro.AggroLockID;
+	targetId = aggro.AggroTargetID;
+	secondaryId = aggro.AggroSecondaryID;
+
+	changedEntries = changed;
+	++captures;
+
+	return changed != 0 || idsChanged;
+}
+
+int AggroMeterSnapshot::GetTopEntries(int* entries, int count, int first, int last) const
+{
+	first = std::max(first, 0);
+	last = std::min(last, Capacity - 1);
+
+	// Insertion into a short sorted prefix. count is small, and so is the meter.
+	int found = 0;
+	for (int entry = first; entry <= last && count > 0; ++entry)
+	{
+		if (spawnIds[entry] == 0)
+			continue;
+
+		int position = found;
+		while (position > 0 && percents[entries[position - 1]] < percents[entry])
+			--position;
+
+		if (position >= count)
+			continue;
+
+		int end = std::min(found, count - 1);
+		for (int i = end; i > position; --i)
+			entries[i] = entries[i - 1];
+
+		entries[position] = entry;
+		found = std::min(found + 1, count);
+	}
+
+	return found;
+}
+
+} // namespace eqlib
@@ -0,0 +1,67 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "EQClasses.h"
+#include "PcClient.h"
+
+namespace eqlib {
+
+// A copy of the aggro meter, laid out as parallel arrays indexed by AggroDataTypes.
+//
+// The caller owns the snapshot and keeps it between frames. Capture reads every entry of the
+// aggro meter once, and compares it with what the snapshot held before as it goes, so the
+// entries that changed since the last Capture are known without a second copy. Nothing is
+// allocated.
+//
+// The aggro meter only stores percentages. The spawn each entry belongs to is filled in from
+// the ids the meter does have (AD_Player is our aggro on AggroTargetID, AD_Secondary is
+// AggroSecondaryID's), and from the group and extended target list when they are passed to
+// Capture. Entries whose spawn isn't known have a spawn id of 0.
+struct AggroMeterSnapshot
+{
+	static constexpr int Capacity = MAX_AGGRO_METER_SIZE;
+
+	uint32_t spawnIds[Capacity] = { 0 };
+	uint16_t percents[Capacity] = { 0 };
+
+	uint32_t lockId = 0;
+	uint32_t targetId = 0;
+	uint32_t secondaryId = 0;
+
+	// Bit N is set if entry N's spawn or percentage changed in the last Capture.
+	uint32_t changedEntries = 0;
+	bool     idsChanged = false;                  // lockId, targetId or secondaryId changed
+	uint32_t captures = 0;
+
+	// Copies |aggro| into the snapshot. |group| fills in the spawns of the AD_Group entries, and
+	// |xtargets| those of the AD_xTarget entries. Returns true if anything changed.
+	EQLIB_OBJECT bool Capture(const AggroMeterManagerClient& aggro, const CGroup* group = nullptr,
+		const ExtendedTargetList* xtargets = nullptr);
+
+	bool HasChanged(int entry) const
+	{
+		return entry >= 0 && entry < Capacity && (changedEntries & (1u << entry)) != 0;
+	}
+
+	// Writes the indexes of the (up to) |count| entries in [first, last] with the highest
+	// percentages to |entries|, highest first. Entries without a spawn are skipped. Returns the
+	// number written.
+	EQLIB_OBJECT int GetTopEntries(int* entries, int count, int first = AD_xTarget1, int last = AD_xTarget20) const;
+};
+
+static_assert(AggroMeterSnapshot::Capacity <= 32, "changedEntries needs a bit for every entry");
+
+} // namespace eqlib
@@ -104,8 +104,13 @@ public:
 	EQLIB_OBJECT bool CanSeeAbility(PcClient*, CAltAbilityData*, bool = true);
 	EQLIB_OBJECT bool CanTrainAbility(PcClient* pWho, CAltAbilityData* pAbility, bool = false, bool = false, bool = false);
 
+	// Looks up the character's owned ability in the given group. Backed by an index of the
+	// character's AA list that is rebuilt only when the list changes.
 	EQLIB_OBJECT CAltAbilityData* GetOwnedAbilityFromGroupID(PcZoneClient* pc, int groupId);
 
+	// Returns the character's rank in the given group, or 0 if no rank is owned.
+	EQLIB_OBJECT int GetOwnedAbilityRankFromGroupID(PcZoneClient* pc, int groupId);
+
 /*0x000*/ RequirementAssociationManager reqAssocManager;
 /*0x248*/ HashTable<CAltAbilityData*>* abilities;
 /*0x250*/
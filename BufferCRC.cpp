@@ -0,0 +1,271 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "EQLib.h"
+#include "Logging.h"
+
+#include <array>
+#include <intrin.h>
+#include <wmmintrin.h>
+
+// GetBufferCRC is the game's CRC-32 (the reflected 0xEDB88320 polynomial, the same one that
+// zlib uses), with |baseValue| acting as the running CRC of any previous data. The native
+// versions below are bit exact with it, so hashes computed here can be mixed with the ones
+// the game computes for its own HashTables.
+
+namespace eqlib {
+
+//============================================================================
+// Slicing-by-8
+//============================================================================
+
+static constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+
+struct CRC32Tables
+{
+	uint32_t table[8][256] = {};
+
+	constexpr CRC32Tables()
+	{
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; ++bit)
+				crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+
+			table[0][i] = crc;
+		}
+
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			for (int slice = 1; slice < 8; ++slice)
+				table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xff];
+		}
+	}
+};
+
+static constexpr CRC32Tables s_crcTables;
+
+// Updates the (pre-inverted) running crc with |length| bytes of |data|.
+static uint32_t CRC32Update_Table(uint32_t crc, const uint8_t* data, size_t length)
+{
+	const auto& t = s_crcTables.table;
+
+	for (; length >= 8; data += 8, length -= 8)
+	{
+		uint32_t low = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24));
+		uint32_t high = data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<uint32_t>(data[7]) << 24);
+
+		crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+			^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+	}
+
+	for (; length > 0; ++data, --length)
+		crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+
+	return crc;
+}
+
+//============================================================================
+// PCLMULQDQ folding
+//============================================================================
+
+// Folds 64 bytes at a time with carry-less multiplies, then reduces to 32 bits with a Barrett
+// reduction. The constants are the bit-reflected ones for the CRC-32 polynomial from Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" paper.
+//
+// Requires |length| >= 64 and a multiple of 16.
+static uint32_t CRC32Update_CLMUL(uint32_t crc, const uint8_t* data, size_t length)
+{
+	alignas(16) static const uint64_t k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+	alignas(16) static const uint64_t k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+	alignas(16) static const uint64_t k5k0[] = { 0x0163cd6124, 0x0000000000 };
+	alignas(16) static const uint64_t poly[] = { 0x01db710641, 0x01f7011641 };
+
+	auto load = [](const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+	auto fold = [](__m128i x, __m128i k, __m128i next)
+	{
+		__m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+		__m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+		return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+	};
+
+	__m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+	__m128i x2 = load(data + 0x10);
+	__m128i x3 = load(data + 0x20);
+	__m128i x4 = load(data + 0x30);
+	data += 64;
+	length -= 64;
+
+	__m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+	for (; length >= 64; data += 64, length -= 64)
+	{
+		x1 = fold(x1, k, load(data));
+		x2 = fold(x2, k, load(data + 0x10));
+		x3 = fold(x3, k, load(data + 0x20));
+		x4 = fold(x4, k, load(data + 0x30));
+	}
+
+	// Fold the four lanes into one, then any remaining 16 byte blocks into that.
+	k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+	x1 = fold(x1, k, x2);
+	x1 = fold(x1, k, x3);
+	x1 = fold(x1, k, x4);
+
+	for (; length >= 16; data += 16, length -= 16)
+		x1 = fold(x1, k, load(data));
+
+	// 128 bits down to 64.
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	__m128i x = _mm_clmulepi64_si128(x1, k, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x);
+
+	k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+	x = _mm_srli_si128(x1, 4);
+	x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+	x1 = _mm_xor_si128(x1, x);
+
+	// Barrett reduction down to 32.
+	k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+	x = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+	x = _mm_clmulepi64_si128(_mm_and_si128(x, mask32), k, 0x00);
+	x1 = _mm_xor_si128(x1, x);
+
+	return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+
+static bool IsCLMULSupported()
+{
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 1);
+
+	// ECX bit 1: PCLMULQDQ
+	return (cpuInfo[2] & (1 << 1)) != 0;
+}
+
+//============================================================================
+// GetBufferCRC
+//============================================================================
+
+uint32_t GetBufferCRC_Table(const char* szBuffer, size_t bufferLength, int baseValue)
+{
+	uint32_t crc = ~static_cast<uint32_t>(baseValue);
+	crc = CRC32Update_Table(crc, reinterpret_cast<const uint8_t*>(szBuffer), bufferLength);
+	return ~crc;
+}
+
+uint32_t GetBufferCRC_CLMUL(const char* szBuffer, size_t bufferLength, int baseValue)
+{
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(szBuffer);
+	uint32_t crc = ~static_cast<uint32_t>(baseValue);
+
+	// Short buffers (which is most strings) aren't worth setting up the fold for.
+	if (bufferLength >= 64)
+	{
+		size_t blockLength = bufferLength & ~static_cast<size_t>(15);
+		crc = CRC32Update_CLMUL(crc, data, blockLength);
+
+		data += blockLength;
+		bufferLength -= blockLength;
+	}
+
+	crc = CRC32Update_Table(crc, data, bufferLength);
+	return ~crc;
+}
+
+using fGetBufferCRC = uint32_t(*)(const char*, size_t, int);
+
+// Until the native implementation has been checked against the game's, use the game's.
+static fGetBufferCRC s_getBufferCRC = EQGetBufferCRC;
+static BufferCRCImplementation s_bufferCRCImplementation = BufferCRCImplementation::Game;
+
+uint32_t GetBufferCRC(const char* szBuffer, size_t bufferLength, int baseValue)
+{
+	return s_getBufferCRC(szBuffer, bufferLength, baseValue);
+}
+
+BufferCRCImplementation GetBufferCRCImplementation()
+{
+	return s_bufferCRCImplementation;
+}
+
+bool SetBufferCRCImplementation(BufferCRCImplementation implementation)
+{
+	switch (implementation)
+	{
+	case BufferCRCImplementation::Game:
+		if (!__MemChecker1)
+			return false;
+		s_getBufferCRC = EQGetBufferCRC;
+		break;
+
+	case BufferCRCImplementation::Table:
+		s_getBufferCRC = GetBufferCRC_Table;
+		break;
+
+	case BufferCRCImplementation::CLMUL:
+		if (!IsCLMULSupported())
+			return false;
+		s_getBufferCRC = GetBufferCRC_CLMUL;
+		break;
+
+	default:
+		return false;
+	}
+
+	s_bufferCRCImplementation = implementation;
+	return true;
+}
+
+bool UseNativeBufferCRC(bool verifyAgainstGame)
+{
+	BufferCRCImplementation implementation = IsCLMULSupported()
+		? BufferCRCImplementation::CLMUL : BufferCRCImplementation::Table;
+
+	if (verifyAgainstGame && __MemChecker1)
+	{
+		fGetBufferCRC native = implementation == BufferCRCImplementation::CLMUL
+			? GetBufferCRC_CLMUL : GetBufferCRC_Table;
+
+		// Cover both the table-only path and the folding path, with and without a base value.
+		std::array<char, 300> probe;
+		for (size_t i = 0; i < probe.size(); ++i)
+			probe[i] = static_cast<char>(i * 131 + 7);
+
+		static const size_t lengths[] = { 0, 1, 7, 8, 15, 63, 64, 65, 127, 128, 255, 300 };
+		static const int baseValues[] = { 0, 1, -1, 0x5a5a5a5a };
+
+		for (size_t length : lengths)
+		{
+			for (int baseValue : baseValues)
+			{
+				uint32_t expected = EQGetBufferCRC(probe.data(), length, baseValue);
+				uint32_t actual = native(probe.data(), length, baseValue);
+
+				if (expected != actual)
+				{
+					SPDLOG_WARN("Native GetBufferCRC does not match the game (length={} base={:#x}: {:#x} != {:#x}), using the game's",
+						length, baseValue, actual, expected);
+					return false;
+				}
+			}
+		}
+	}
+
+	return SetBufferCRCImplementation(implementation);
+}
+
+} // namespace eqlib
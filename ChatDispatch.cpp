@@ -0,0 +1,599 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "ChatDispatch.h"
+
+#include "ItemLinks.h"
+#include "UI.h"
+
+#include <cctype>
+
+namespace eqlib {
+
+//============================================================================
+// MultiPatternMatcher
+//============================================================================
+
+MultiPatternMatcher::MultiPatternMatcher(bool caseSensitive)
+	: m_caseSensitive(caseSensitive)
+{
+}
+
+bool MultiPatternMatcher::AddPattern(std::string_view pattern, int patternId)
+{
+	if (pattern.empty())
+		return false;
+
+	m_patterns.push_back(Pattern{ std::string(pattern), patternId, pattern.length() });
+	m_compiled = false;
+
+	return true;
+}
+
+void MultiPatternMatcher::Clear()
+{
+	m_patterns.clear();
+	m_compiled = false;
+
+	m_numClasses = 0;
+	m_delta.clear();
+	m_dictLink.clear();
+	m_outputStart.clear();
+	m_outputs.clear();
+}
+
+void MultiPatternMatcher::Compile()
+{
+	m_delta.clear();
+	m_dictLink.clear();
+	m_outputStart.clear();
+	m_outputs.clear();
+
+	// Build the reduced alphabet. Class 0 is every byte that doesn't appear in a pattern.
+	memset(m_charClass, 0, sizeof(m_charClass));
+	m_numClasses = 1;
+
+	for (const Pattern& pattern : m_patterns)
+	{
+		for (char ch : pattern.text)
+		{
+			uint8_t c = static_cast<uint8_t>(ch);
+			if (m_charClass[c] != 0)
+				continue;
+
+			if (m_numClasses == 256)
+				break;
+
+			uint8_t cls = static_cast<uint8_t>(m_numClasses++);
+			m_charClass[c] = cls;
+
+			if (!m_caseSensitive)
+			{
+				m_charClass[static_cast<uint8_t>(tolower(c))] = cls;
+				m_charClass[static_cast<uint8_t>(toupper(c))] = cls;
+			}
+		}
+	}
+
+	// Build the trie. Missing edges are -1 until the failure links are resolved below.
+	std::vector<std::vector<int>> nodeOutputs(1);
+	m_delta.assign(m_numClasses, -1);
+
+	for (int index = 0; index < static_cast<int>(m_patterns.size()); ++index)
+	{
+		int state = 0;
+
+		for (char ch : m_patterns[index].text)
+		{
+			int& next = m_delta[state * m_numClasses + m_charClass[static_cast<uint8_t>(ch)]];
+			if (next == -1)
+			{
+				next = static_cast<int>(nodeOutputs.size());
+				nodeOutputs.emplace_back();
+				m_delta.resize(m_delta.size() + m_numClasses, -1);
+			}
+
+			state = m_delta[state * m_numClasses + m_charClass[static_cast<uint8_t>(ch)]];
+		}
+
+		nodeOutputs[state].push_back(index);
+	}
+
+	const int numStates = static_cast<int>(nodeOutputs.size());
+	std::vector<int> failure(numStates, 0);
+	m_dictLink.assign(numStates, -1);
+
+	// Breadth-first pass to fill in the failure transitions. Every state's failure state is
+	// shallower than it is, so its row is already complete by the time we need it.
+	std::vector<int> queue;
+	queue.reserve(numStates);
+
+	for (int cls = 0; cls < m_numClasses; ++cls)
+	{
+		int& next = m_delta[cls];
+		if (next == -1)
+		{
+			next = 0;
+		}
+		else
+		{
+			queue.push_back(next);
+		}
+	}
+
+	for (size_t head = 0; head < queue.size(); ++head)
+	{
+		int state = queue[head];
+
+		for (int cls = 0; cls < m_numClasses; ++cls)
+		{
+			int& next = m_delta[state * m_numClasses + cls];
+			int fallback = m_delta[failure[state] * m_numClasses + cls];
+
+			if (next == -1)
+			{
+				next = fallback;
+			}
+			else
+			{
+				failure[next] = fallback;
+				m_dictLink[next] = !nodeOutputs[fallback].empty() ? fallback : m_dictLink[fallback];
+				queue.push_back(next);
+			}
+		}
+	}
+
+	// Flatten the outputs.
+	m_outputStart.resize(numStates + 1);
+	for (int state = 0; state < numStates; ++state)
+	{
+		m_outputStart[state] = static_cast<int>(m_outputs.size());
+		m_outputs.insert(m_outputs.end(), nodeOutputs[state].begin(), nodeOutputs[state].end());
+	}
+	m_outputStart[numStates] = static_cast<int>(m_outputs.size());
+
+	m_compiled = true;
+}
+
+bool MultiPatternMatcher::MatchesAny(std::string_view text) const
+{
+	if (!m_compiled || m_patterns.empty())
+		return false;
+
+	int state = 0;
+	for (char ch : text)
+	{
+		state = m_delta[state * m_numClasses + m_charClass[static_cast<uint8_t>(ch)]];
+
+		if (m_outputStart[state] != m_outputStart[state + 1] || m_dictLink[state] != -1)
+			return true;
+	}
+
+	return false;
+}
+
+//============================================================================
+// ChatDispatchTable
+//============================================================================
+
+ChatDispatchTable::ChatDispatchTable()
+{
+	std::fill(std::begin(m_colorMatcherIndex), std::end(m_colorMatcherIndex), static_cast<int16_t>(-1));
+}
+
+bool ChatDispatchTable::AddFilter(int filterId, std::string_view pattern, int color)
+{
+	if (pattern.empty())
+		return false;
+
+	if (color != AnyColor && (color < 0 || color >= CHAT_DISPATCH_COLOR_COUNT))
+		return false;
+
+	m_filters.push_back(FilterEntry{ filterId, std::string(pattern), color });
+	m_compiled = false;
+	return true;
+}
+
+void ChatDispatchTable::RemoveFilter(int filterId)
+{
+	auto iter = std::remove_if(m_filters.begin(), m_filters.end(),
+		[filterId](const FilterEntry& entry) { return entry.filterId == filterId; });
+
+	if (iter != m_filters.end())
+	{
+		m_filters.erase(iter, m_filters.end());
+		m_compiled = false;
+	}
+}
+
+void ChatDispatchTable::ClearFilters()
+{
+	m_filters.clear();
+	m_compiled = false;
+}
+
+void ChatDispatchTable::Compile()
+{
+	m_anyColorMatcher.Clear();
+	m_colorMatchers.clear();
+	std::fill(std::begin(m_colorMatcherIndex), std::end(m_colorMatcherIndex), static_cast<int16_t>(-1));
+
+	// Assign a matcher to every color that has filters of its own.
+	for (const FilterEntry& entry : m_filters)
+	{
+		if (entry.color != AnyColor && m_colorMatcherIndex[entry.color] == -1)
+		{
+			m_colorMatcherIndex[entry.color] = static_cast<int16_t>(m_colorMatchers.size());
+			m_colorMatchers.emplace_back();
+		}
+	}
+
+	// The pattern id handed to the matchers is a slot shared by every entry of the same filter
+	// id, so that duplicate matches can be collapsed when dispatching.
+	std::unordered_map<int, int> slots;
+	m_slotFilterIds.clear();
+
+	for (const FilterEntry& entry : m_filters)
+	{
+		auto [iter, added] = slots.emplace(entry.filterId, static_cast<int>(m_slotFilterIds.size()));
+		if (added)
+			m_slotFilterIds.push_back(entry.filterId);
+
+		int slot = iter->second;
+
+		if (entry.color == AnyColor)
+		{
+			m_anyColorMatcher.AddPattern(entry.pattern, slot);
+
+			for (MultiPatternMatcher& matcher : m_colorMatchers)
+				matcher.AddPattern(entry.pattern, slot);
+		}
+		else
+		{
+			m_colorMatchers[m_colorMatcherIndex[entry.color]].AddPattern(entry.pattern, slot);
+		}
+	}
+
+	m_anyColorMatcher.Compile();
+	for (MultiPatternMatcher& matcher : m_colorMatchers)
+		matcher.Compile();
+
+	m_firedGeneration.assign(m_slotFilterIds.size(), 0);
+	m_generation = 0;
+	m_compiled = true;
+}
+
+void ChatDispatchTable::UpdateWindows(const CChatWindowManager* pChatManager)
+{
+	m_windows.clear();
+	std::fill(std::begin(m_channelWindows), std::end(m_channelWindows), nullptr);
+
+	if (!pChatManager)
+		return;
+
+	for (CChatWindow* pWindow : pChatManager->ChatWindows)
+	{
+		if (pWindow)
+			m_windows.push_back(pWindow);
+	}
+
+	std::copy(std::begin(pChatManager->ChannelMap), std::end(pChatManager->ChannelMap), m_channelWindows);
+}
+
+//============================================================================
+// ChatEventMatcher
+//============================================================================
+
+// Size below which newly added triggers stay in the secondary matcher.
+constexpr int CHAT_EVENT_MIN_RECENT_TRIGGERS = 32;
+
+static size_t FindLiteral(std::string_view text, std::string_view literal, size_t from, bool caseSensitive)
+{
+	if (caseSensitive)
+		return text.find(literal, from);
+
+	if (from > text.size())
+		return std::string_view::npos;
+
+	auto iter = std::search(text.begin() + from, text.end(), literal.begin(), literal.end(),
+		[](char a, char b) { return tolower(static_cast<uint8_t>(a)) == tolower(static_cast<uint8_t>(b)); });
+
+	return iter == text.end() ? std::string_view::npos : static_cast<size_t>(iter - text.begin());
+}
+
+ChatEventMatcher::ChatEventMatcher(bool caseSensitive)
+	: m_caseSensitive(caseSensitive)
+	, m_mainMatcher(caseSensitive)
+	, m_recentMatcher(caseSensitive)
+{
+}
+
+bool ChatEventMatcher::AddTrigger(int triggerId, std::string_view pattern)
+{
+	if (pattern.empty())
+		return false;
+
+	Trigger trigger;
+	trigger.triggerId = triggerId;
+	trigger.anchorPiece = -1;
+	trigger.removed = false;
+
+	// Split the pattern into literal text and #*# / #n# wildcards.
+	size_t pos = 0;
+	while (pos < pattern.size())
+	{
+		int capture = -1;
+
+		if (pattern[pos] == '#' && pos + 2 < pattern.size() && pattern[pos + 2] == '#')
+		{
+			char ch = pattern[pos + 1];
+			if (ch == '*')
+				capture = 0;
+			else if (ch >= '1' && ch <= '9')
+				capture = ch - '0';
+		}
+
+		if (capture != -1)
+		{
+			trigger.pieces.push_back(Piece{ std::string(), capture });
+			pos += 3;
+			continue;
+		}
+
+		// Extend the literal up to the next wildcard.
+		size_t end = pos + 1;
+		while (end < pattern.size())
+		{
+			if (pattern[end] == '#' && end + 2 < pattern.size() && pattern[end + 2] == '#'
+				&& (pattern[end + 1] == '*' || (pattern[end + 1] >= '1' && pattern[end + 1] <= '9')))
+			{
+				break;
+			}
+
+			++end;
+		}
+
+		trigger.pieces.push_back(Piece{ std::string(pattern.substr(pos, end - pos)), -1 });
+		pos = end;
+	}
+
+	size_t anchorLength = 0;
+	for (int i = 0; i < static_cast<int>(trigger.pieces.size()); ++i)
+	{
+		if (trigger.pieces[i].literal.length() > anchorLength)
+		{
+			anchorLength = trigger.pieces[i].literal.length();
+			trigger.anchorPiece = i;
+		}
+	}
+
+	m_triggers.push_back(std::move(trigger));
+	m_recentMatcher.Clear();
+
+	return true;
+}
+
+bool ChatEventMatcher::RemoveTrigger(int triggerId)
+{
+	bool found = false;
+
+	for (Trigger& trigger : m_triggers)
+	{
+		if (!trigger.removed && trigger.triggerId == triggerId)
+		{
+			trigger.removed = true;
+			++m_numRemoved;
+			found = true;
+		}
+	}
+
+	// Removed triggers are skipped while matching. Once they make up half of the set, it's
+	// cheaper to rebuild than to keep finding them as candidates.
+	if (found && m_numRemoved * 2 > static_cast<int>(m_triggers.size()))
+	{
+		Compact();
+	}
+
+	return found;
+}
+
+void ChatEventMatcher::Clear()
+{
+	m_triggers.clear();
+	m_numRemoved = 0;
+	m_mainMatcher.Clear();
+	m_recentMatcher.Clear();
+	m_mainCount = 0;
+	m_wildcardTriggers.clear();
+}
+
+void ChatEventMatcher::Compact()
+{
+	m_triggers.erase(std::remove_if(m_triggers.begin(), m_triggers.end(),
+		[](const Trigger& trigger) { return trigger.removed; }), m_triggers.end());
+
+	m_numRemoved = 0;
+	m_mainMatcher.Clear();
+	m_recentMatcher.Clear();
+	m_mainCount = 0;
+}
+
+void ChatEventMatcher::UpdateMatchers()
+{
+	const int numTriggers = static_cast<int>(m_triggers.size());
+	const int numRecent = numTriggers - m_mainCount;
+
+	// Fold the recent triggers into the main matcher once there are enough of them, so the
+	// cost of rebuilding the main matcher is spread across many additions.
+	if (!m_mainMatcher.IsCompiled() || numRecent > std::max(CHAT_EVENT_MIN_RECENT_TRIGGERS, m_mainCount / 4))
+	{
+		m_mainMatcher.Clear();
+		for (int index = 0; index < numTriggers; ++index)
+		{
+			const Trigger& trigger = m_triggers[index];
+			if (!trigger.removed && trigger.anchorPiece != -1)
+				m_mainMatcher.AddPattern(trigger.pieces[trigger.anchorPiece].literal, index);
+		}
+
+		m_mainMatcher.Compile();
+		m_mainCount = numTriggers;
+		m_recentMatcher.Clear();
+	}
+
+	if (!m_recentMatcher.IsCompiled())
+	{
+		m_recentMatcher.Clear();
+		for (int index = m_mainCount; index < numTriggers; ++index)
+		{
+			const Trigger& trigger = m_triggers[index];
+			if (!trigger.removed && trigger.anchorPiece != -1)
+				m_recentMatcher.AddPattern(trigger.pieces[trigger.anchorPiece].literal, index);
+		}
+
+		m_recentMatcher.Compile();
+
+		m_wildcardTriggers.clear();
+		for (int index = 0; index < numTriggers; ++index)
+		{
+			if (m_triggers[index].anchorPiece == -1)
+				m_wildcardTriggers.push_back(index);
+		}
+
+		m_checkedGeneration.assign(numTriggers, 0);
+		m_generation = 0;
+	}
+}
+
+bool ChatEventMatcher::Verify(const Trigger& trigger, std::string_view line, ChatEventMatch& match) const
+{
+	for (std::string_view& capture : match.captures)
+		capture = std::string_view();
+
+	size_t pos = 0;
+	int pendingCapture = -1;
+	size_t pendingStart = 0;
+
+	const int numPieces = static_cast<int>(trigger.pieces.size());
+	for (int i = 0; i < numPieces; ++i)
+	{
+		const Piece& piece = trigger.pieces[i];
+
+		if (piece.capture != -1)
+		{
+			// Back to back wildcards: the first one matches nothing.
+			if (pendingCapture > 0)
+				match.captures[pendingCapture] = line.substr(pos, 0);
+
+			pendingCapture = piece.capture;
+			pendingStart = pos;
+			continue;
+		}
+
+		size_t found;
+		if (pendingCapture == -1)
+		{
+			// Not preceded by a wildcard, so it has to match right here.
+			if (line.size() - pos < piece.literal.size()
+				|| FindLiteral(line.substr(pos, piece.literal.size()), piece.literal, 0, m_caseSensitive) != 0)
+			{
+				return false;
+			}
+
+			found = pos;
+		}
+		else if (i == numPieces - 1)
+		{
+			// The last literal has to end the line.
+			if (line.size() < pos + piece.literal.size())
+				return false;
+
+			found = line.size() - piece.literal.size();
+			if (FindLiteral(line.substr(found), piece.literal, 0, m_caseSensitive) != 0)
+				return false;
+		}
+		else
+		{
+			found = FindLiteral(line, piece.literal, pos, m_caseSensitive);
+			if (found == std::string_view::npos)
+				return false;
+		}
+
+		if (pendingCapture > 0)
+			match.captures[pendingCapture] = line.substr(pendingStart, found - pendingStart);
+
+		pendingCapture = -1;
+		pos = found + piece.literal.size();
+	}
+
+	if (pendingCapture == -1)
+	{
+		if (pos != line.size())
+			return false;
+	}
+	else if (pendingCapture > 0)
+	{
+		match.captures[pendingCapture] = line.substr(pendingStart);
+	}
+
+	match.triggerId = trigger.triggerId;
+	match.captures[0] = line;
+	return true;
+}
+
+int ChatEventMatcher::Match(std::string_view line, std::vector<ChatEventMatch>& outMatches)
+{
+	outMatches.clear();
+
+	if (m_triggers.empty())
+		return 0;
+
+	UpdateMatchers();
+
+	if (++m_generation == 0)
+	{
+		std::fill(m_checkedGeneration.begin(), m_checkedGeneration.end(), 0);
+		m_generation = 1;
+	}
+
+	ChatEventMatch match;
+	auto checkCandidate = [&](int index, size_t, size_t)
+	{
+		if (m_checkedGeneration[index] == m_generation)
+			return;
+		m_checkedGeneration[index] = m_generation;
+
+		const Trigger& trigger = m_triggers[index];
+		if (!trigger.removed && Verify(trigger, line, match))
+			outMatches.push_back(match);
+	};
+
+	m_mainMatcher.Match(line, checkCandidate);
+	m_recentMatcher.Match(line, checkCandidate);
+
+	for (int index : m_wildcardTriggers)
+		checkCandidate(index, 0, 0);
+
+	return static_cast<int>(outMatches.size());
+}
+
+int ChatEventMatcher::MatchStripped(std::string_view line, std::vector<ChatEventMatch>& outMatches)
+{
+	m_stripBuffer.assign(line);
+	StripTextLinks(m_stripBuffer.data());
+
+	return Match(std::string_view(m_stripBuffer.c_str()), outMatches);
+}
+
+} // namespace eqlib
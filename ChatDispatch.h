@@ -0,0 +1,311 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "ChatFilters.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+class CChatWindow;
+class CChatWindowManager;
+
+//============================================================================
+// MultiPatternMatcher
+//============================================================================
+
+// Finds every occurrence of a set of literal patterns in a single pass over the text
+// (Aho-Corasick). Patterns are added up front and then compiled into a transition table
+// over a reduced alphabet: only bytes that appear in some pattern get their own column,
+// everything else shares one. Case-insensitive matching is done by folding the alphabet,
+// so it costs nothing extra per character.
+class MultiPatternMatcher
+{
+public:
+	EQLIB_OBJECT MultiPatternMatcher(bool caseSensitive = false);
+
+	// Adds a pattern to the set. |patternId| is handed back to the match callback. Empty
+	// patterns are rejected. Adding a pattern discards the compiled table.
+	EQLIB_OBJECT bool AddPattern(std::string_view pattern, int patternId);
+	EQLIB_OBJECT void Clear();
+
+	// Builds the transition table. Must be called after adding patterns and before matching.
+	EQLIB_OBJECT void Compile();
+
+	bool IsCompiled() const { return m_compiled; }
+	bool IsCaseSensitive() const { return m_caseSensitive; }
+	size_t GetPatternCount() const { return m_patterns.size(); }
+	size_t GetStateCount() const { return m_outputStart.empty() ? 0 : m_outputStart.size() - 1; }
+
+	// Calls |callback(patternId, start, end)| for every match in |text|, in order of the
+	// match's end position. [start, end) is the range of the match within |text|.
+	template <typename Fn>
+	void Match(std::string_view text, Fn&& callback) const
+	{
+		if (!m_compiled || m_patterns.empty())
+			return;
+
+		int state = 0;
+		for (size_t pos = 0; pos < text.size(); ++pos)
+		{
+			state = m_delta[state * m_numClasses + m_charClass[static_cast<uint8_t>(text[pos])]];
+
+			for (int node = state; node != -1; node = m_dictLink[node])
+			{
+				for (int i = m_outputStart[node]; i < m_outputStart[node + 1]; ++i)
+				{
+					const Pattern& pattern = m_patterns[m_outputs[i]];
+					callback(pattern.id, pos + 1 - pattern.length, pos + 1);
+				}
+			}
+		}
+	}
+
+	// Returns true if any of the patterns occur in |text|.
+	EQLIB_OBJECT bool MatchesAny(std::string_view text) const;
+
+private:
+	struct Pattern
+	{
+		std::string text;
+		int id;
+		size_t length;
+	};
+
+	std::vector<Pattern> m_patterns;
+	bool m_caseSensitive = false;
+	bool m_compiled = false;
+
+	// compiled form
+	uint8_t m_charClass[256] = { 0 };
+	int m_numClasses = 0;
+	std::vector<int> m_delta;           // [state * m_numClasses + class] -> state
+	std::vector<int> m_dictLink;        // nearest suffix state that has outputs, or -1
+	std::vector<int> m_outputStart;     // [state] -> first index into m_outputs
+	std::vector<int> m_outputs;         // indices into m_patterns
+};
+
+//============================================================================
+// ChatDispatchTable
+//============================================================================
+
+// One past the highest chat color that can be dispatched by color. Colors outside of
+// this range are only tested against filters registered for all colors.
+constexpr int CHAT_DISPATCH_COLOR_COUNT = USERCOLOR_SAY + NUM_USER_COLORS;
+
+// Compiled routing for incoming chat lines.
+//
+// Filters are registered against a single chat color or against all colors, and then compiled
+// into one matcher per color. An incoming line is only tested against the filters that can fire
+// for its color, and all of them are tested in a single pass over the text. Colors that have no
+// filters of their own share the matcher for the all-colors filters.
+//
+// The table also keeps a flattened copy of the chat manager's window list and channel map, so
+// routing a line to its window doesn't need to walk the manager's linked list.
+class ChatDispatchTable
+{
+public:
+	static constexpr int AnyColor = -1;
+
+	EQLIB_OBJECT ChatDispatchTable();
+
+	// Registers a filter that fires when |pattern| occurs in a line of the given color. The
+	// same filter id may be registered more than once, with different patterns or colors; it
+	// fires at most once per line. Empty patterns and colors outside of AnyColor and
+	// [0, CHAT_DISPATCH_COLOR_COUNT) are rejected. Changing the filters requires another call
+	// to Compile.
+	EQLIB_OBJECT bool AddFilter(int filterId, std::string_view pattern, int color = AnyColor);
+	EQLIB_OBJECT void RemoveFilter(int filterId);
+	EQLIB_OBJECT void ClearFilters();
+
+	EQLIB_OBJECT void Compile();
+	bool IsCompiled() const { return m_compiled; }
+
+	size_t GetFilterCount() const { return m_filters.size(); }
+
+	// Calls |callback(filterId)| once for each filter that matches |line| in the given color.
+	// Returns the number of filters that fired. The table must be compiled. Not safe to call
+	// from multiple threads at once.
+	template <typename Fn>
+	int Dispatch(int color, std::string_view line, Fn&& callback) const
+	{
+		if (!m_compiled)
+			return 0;
+
+		if (++m_generation == 0)
+		{
+			std::fill(m_firedGeneration.begin(), m_firedGeneration.end(), 0);
+			m_generation = 1;
+		}
+
+		int fired = 0;
+		GetMatcher(color).Match(line,
+			[&](int slot, size_t, size_t)
+			{
+				if (m_firedGeneration[slot] != m_generation)
+				{
+					m_firedGeneration[slot] = m_generation;
+					++fired;
+
+					callback(m_slotFilterIds[slot]);
+				}
+			});
+
+		return fired;
+	}
+
+	// Takes a snapshot of the chat windows and the channel to window map. Call this after
+	// chat windows are created or destroyed, or after the channel map changes.
+	EQLIB_OBJECT void UpdateWindows(const CChatWindowManager* pChatManager);
+
+	// Returns the window that the given chat channel is routed to.
+	CChatWindow* GetChannelWindow(int channel) const
+	{
+		if (channel < 0 || channel >= NUM_CHAT_CHANNELS)
+			return nullptr;
+
+		return m_channelWindows[channel];
+	}
+
+	const std::vector<CChatWindow*>& GetWindows() const { return m_windows; }
+
+private:
+	const MultiPatternMatcher& GetMatcher(int color) const
+	{
+		if (color >= 0 && color < CHAT_DISPATCH_COLOR_COUNT && m_colorMatcherIndex[color] != -1)
+			return m_colorMatchers[m_colorMatcherIndex[color]];
+
+		return m_anyColorMatcher;
+	}
+
+	struct FilterEntry
+	{
+		int filterId;
+		std::string pattern;
+		int color;
+	};
+
+	std::vector<FilterEntry> m_filters;
+	bool m_compiled = false;
+
+	MultiPatternMatcher m_anyColorMatcher;
+	std::vector<MultiPatternMatcher> m_colorMatchers;
+	int16_t m_colorMatcherIndex[CHAT_DISPATCH_COLOR_COUNT];
+
+	// The matchers report a slot per distinct filter id, so that a filter registered with
+	// several patterns is only counted once per line.
+	std::vector<int> m_slotFilterIds;                // [slot] -> filter id
+	mutable std::vector<uint32_t> m_firedGeneration; // [slot] -> generation it last fired in
+	mutable uint32_t m_generation = 0;
+
+	CChatWindow* m_channelWindows[NUM_CHAT_CHANNELS] = { nullptr };
+	std::vector<CChatWindow*> m_windows;
+};
+
+//============================================================================
+// ChatEventMatcher
+//============================================================================
+
+// Maximum number of numbered captures (#1# through #9#) in an event pattern.
+constexpr int CHAT_EVENT_MAX_CAPTURES = 9;
+
+struct ChatEventMatch
+{
+	int triggerId = 0;
+
+	// captures[0] is the whole line. captures[1..9] hold the text matched by #1# through #9#,
+	// and are empty if the pattern doesn't use that capture. These reference the matched text
+	// and are only valid for as long as it is.
+	std::string_view captures[CHAT_EVENT_MAX_CAPTURES + 1];
+};
+
+// Matches a line of chat against every registered event trigger in a single pass.
+//
+// Trigger patterns use the same syntax as macro events: literal text, with #*# matching any
+// run of text and #1# through #9# matching and capturing any run of text. A pattern must match
+// the whole line, so a pattern that should match anywhere in a line starts and ends with #*#.
+// Wildcards match the shortest run of text that lets the next literal segment match.
+//
+// The longest literal segment of every trigger is compiled into a MultiPatternMatcher. Only
+// triggers whose segment occurs in the line are verified against the full pattern, so the
+// per-line cost is one scan plus a check of the few triggers that could plausibly match.
+//
+// Adding and removing triggers does not rebuild everything. New triggers are compiled into a
+// small secondary matcher that is folded into the main one once it grows, and removed triggers
+// are skipped until enough of them accumulate to be worth compacting.
+class ChatEventMatcher
+{
+public:
+	EQLIB_OBJECT ChatEventMatcher(bool caseSensitive = true);
+
+	// Registers a trigger. Returns false if the pattern is empty. Any '#' that isn't part of a
+	// #*# or #n# wildcard is literal text, like in macro events, so there is no malformed pattern.
+	// Trigger ids do not need to be unique, but RemoveTrigger removes every trigger with the
+	// given id.
+	EQLIB_OBJECT bool AddTrigger(int triggerId, std::string_view pattern);
+	EQLIB_OBJECT bool RemoveTrigger(int triggerId);
+	EQLIB_OBJECT void Clear();
+
+	size_t GetTriggerCount() const { return m_triggers.size() - m_numRemoved; }
+
+	// Matches |line| against all triggers. Matches are written to |outMatches|, which is cleared
+	// first, and the number of matches is returned. Reusing the same vector between calls avoids
+	// allocating once it has grown large enough.
+	EQLIB_OBJECT int Match(std::string_view line, std::vector<ChatEventMatch>& outMatches);
+
+	// Same as Match, but item and other text links are stripped from the line first (see
+	// StripTextLinks). Captures reference an internal buffer and are only valid until the next
+	// call to MatchStripped.
+	EQLIB_OBJECT int MatchStripped(std::string_view line, std::vector<ChatEventMatch>& outMatches);
+
+private:
+	struct Piece
+	{
+		std::string literal;     // empty for wildcards
+		int capture;             // -1 for literals, 0 for #*#, 1-9 for captures
+	};
+
+	struct Trigger
+	{
+		int triggerId;
+		std::vector<Piece> pieces;
+		int anchorPiece;         // index of the longest literal piece, or -1
+		bool removed;
+	};
+
+	bool Verify(const Trigger& trigger, std::string_view line, ChatEventMatch& match) const;
+	void UpdateMatchers();
+	void Compact();
+
+	bool m_caseSensitive;
+	std::vector<Trigger> m_triggers;
+	int m_numRemoved = 0;
+
+	// m_mainMatcher covers triggers [0, m_mainCount), m_recentMatcher covers the rest.
+	MultiPatternMatcher m_mainMatcher;
+	MultiPatternMatcher m_recentMatcher;
+	int m_mainCount = 0;
+	std::vector<int> m_wildcardTriggers;   // triggers without any literal text
+
+	std::vector<uint32_t> m_checkedGeneration;
+	uint32_t m_generation = 0;
+	std::string m_stripBuffer;
+};
+
+} // namespace eqlib
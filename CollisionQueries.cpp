@@ -0,0 +1,271 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "CollisionQueries.h"
+
+#include "Globals.h"
+
+#include <cmath>
+
+namespace eqlib {
+
+//============================================================================
+// GameCollisionQueryBackend
+//============================================================================
+
+bool GameCollisionQueryBackend::HasLineOfSight(const LineOfSightQuery& query)
+{
+	return CastRayLoc(query.source, query.race, query.target.X, query.target.Y, query.target.Z) != 0;
+}
+
+//============================================================================
+// CollisionQueryBatcher
+//============================================================================
+
+static const char* s_collisionQueryStatisticNames[] = {
+	"Queries",
+	"Deduplicated",
+	"CacheHits",
+	"BackendCalls",
+	"Invalidated",
+	"Expired",
+};
+static_assert(std::size(s_collisionQueryStatisticNames) == static_cast<size_t>(CollisionQueryStatistic::Count),
+	"Statistic names out of sync with CollisionQueryStatistic");
+
+size_t CollisionQueryBatcher::QuantizedKeyHash::operator()(const QuantizedKey& key) const
+{
+	uint64_t hash = static_cast<uint32_t>(key.race);
+	for (int32_t coord : key.coords)
+	{
+		hash ^= static_cast<uint32_t>(coord);
+		hash *= 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 29;
+	}
+
+	return static_cast<size_t>(hash);
+}
+
+CollisionQueryBatcher::CollisionQueryBatcher(CollisionQueryBackend* backend)
+	: m_backend(backend)
+{
+}
+
+void CollisionQueryBatcher::SetPositionTolerance(float tolerance)
+{
+	if (tolerance <= 0.0f)
+		tolerance = 1.0f;
+
+	if (tolerance != m_tolerance)
+	{
+		m_tolerance = tolerance;
+		m_inverseTolerance = 1.0f / tolerance;
+
+		// Keys from the old grid don't mean anything on the new one.
+		InvalidateAll();
+	}
+}
+
+void CollisionQueryBatcher::SetMaxCacheSize(size_t maxEntries)
+{
+	m_maxCacheSize = maxEntries;
+
+	if (m_cache.size() > m_maxCacheSize)
+		InvalidateAll();
+}
+
+CollisionQueryBatcher::QuantizedKey CollisionQueryBatcher::MakeKey(const LineOfSightQuery& query) const
+{
+	auto quantize = [this](float value) { return static_cast<int32_t>(floorf(value * m_inverseTolerance)); };
+
+	QuantizedKey key;
+	key.coords[0] = quantize(query.source.X);
+	key.coords[1] = quantize(query.source.Y);
+	key.coords[2] = quantize(query.source.Z);
+	key.coords[3] = quantize(query.target.X);
+	key.coords[4] = quantize(query.target.Y);
+	key.coords[5] = quantize(query.target.Z);
+	key.race = query.race;
+	return key;
+}
+
+int CollisionQueryBatcher::Submit(const LineOfSightQuery& query)
+{
+	if (m_executed)
+	{
+		m_pending.clear();
+		m_pendingKeys.clear();
+		m_batchIndex.clear();
+		m_results.clear();
+		m_executed = false;
+	}
+
+	++m_statistics[static_cast<int>(CollisionQueryStatistic::Queries)];
+
+	QuantizedKey key = MakeKey(query);
+
+	auto result = m_batchIndex.emplace(key, static_cast<int>(m_pending.size()));
+	if (!result.second)
+	{
+		++m_statistics[static_cast<int>(CollisionQueryStatistic::Deduplicated)];
+		return result.first->second;
+	}
+
+	m_pending.push_back(query);
+	m_pendingKeys.push_back(key);
+	return result.first->second;
+}
+
+bool CollisionQueryBatcher::Resolve(const QuantizedKey& key, const LineOfSightQuery& query, uint32_t currentTimeMs)
+{
+	auto iter = m_cache.find(key);
+	if (iter != m_cache.end())
+	{
+		if (currentTimeMs - iter->second.timestamp <= m_cacheLifetime)
+		{
+			++m_statistics[static_cast<int>(CollisionQueryStatistic::CacheHits)];
+			return iter->second.result;
+		}
+
+		++m_statistics[static_cast<int>(CollisionQueryStatistic::Expired)];
+	}
+
+	++m_statistics[static_cast<int>(CollisionQueryStatistic::BackendCalls)];
+	bool hasLineOfSight = GetBackend()->HasLineOfSight(query);
+
+	if (iter != m_cache.end())
+	{
+		iter->second = CacheEntry{ query.source, query.target, currentTimeMs, hasLineOfSight };
+	}
+	else if (m_maxCacheSize > 0)
+	{
+		m_cache.emplace(key, CacheEntry{ query.source, query.target, currentTimeMs, hasLineOfSight });
+	}
+
+	return hasLineOfSight;
+}
+
+int CollisionQueryBatcher::Execute(uint32_t currentTimeMs)
+{
+	uint32_t backendCalls = m_statistics[static_cast<int>(CollisionQueryStatistic::BackendCalls)];
+
+	m_results.resize(m_pending.size());
+	for (size_t i = 0; i < m_pending.size(); ++i)
+	{
+		m_results[i] = Resolve(m_pendingKeys[i], m_pending[i], currentTimeMs) ? 1 : 0;
+	}
+
+	m_executed = true;
+	Trim(currentTimeMs);
+
+	return static_cast<int>(m_statistics[static_cast<int>(CollisionQueryStatistic::BackendCalls)] - backendCalls);
+}
+
+bool CollisionQueryBatcher::HasLineOfSight(const LineOfSightQuery& query, uint32_t currentTimeMs)
+{
+	++m_statistics[static_cast<int>(CollisionQueryStatistic::Queries)];
+
+	bool result = Resolve(MakeKey(query), query, currentTimeMs);
+	Trim(currentTimeMs);
+
+	return result;
+}
+
+void CollisionQueryBatcher::Trim(uint32_t currentTimeMs)
+{
+	if (m_cache.size() <= m_maxCacheSize)
+		return;
+
+	for (auto iter = m_cache.begin(); iter != m_cache.end();)
+	{
+		if (currentTimeMs - iter->second.timestamp > m_cacheLifetime)
+			iter = m_cache.erase(iter);
+		else
+			++iter;
+	}
+
+	// Everything is recent. Rather than track usage just to pick what to evict, start over.
+	if (m_cache.size() > m_maxCacheSize)
+	{
+		m_statistics[static_cast<int>(CollisionQueryStatistic::Invalidated)] += static_cast<uint32_t>(m_cache.size());
+		m_cache.clear();
+	}
+}
+
+// Squared distance from |point| to the segment [a, b].
+static float DistanceToSegmentSquared(const CVector3& point, const CVector3& a, const CVector3& b)
+{
+	CVector3 ab = b - a;
+	CVector3 ap = point - a;
+
+	float lengthSquared = ab.GetLengthSquared();
+	float t = lengthSquared > 0.0f ? (ap.X * ab.X + ap.Y * ab.Y + ap.Z * ab.Z) / lengthSquared : 0.0f;
+	t = std::clamp(t, 0.0f, 1.0f);
+
+	return (ap - ab * t).GetLengthSquared();
+}
+
+int CollisionQueryBatcher::InvalidateNear(const CVector3& position, float radius)
+{
+	// Allow for the endpoints of other queries that share the entry being anywhere in the cell.
+	float reach = radius + m_tolerance * 1.7320508f;
+	float reachSquared = reach * reach;
+	int removed = 0;
+
+	for (auto iter = m_cache.begin(); iter != m_cache.end();)
+	{
+		if (DistanceToSegmentSquared(position, iter->second.source, iter->second.target) <= reachSquared)
+		{
+			iter = m_cache.erase(iter);
+			++removed;
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	m_statistics[static_cast<int>(CollisionQueryStatistic::Invalidated)] += removed;
+	return removed;
+}
+
+void CollisionQueryBatcher::InvalidateAll()
+{
+	m_statistics[static_cast<int>(CollisionQueryStatistic::Invalidated)] += static_cast<uint32_t>(m_cache.size());
+	m_cache.clear();
+}
+
+uint32_t CollisionQueryBatcher::GetStatistic(int statistic) const
+{
+	if (statistic < 0 || statistic >= static_cast<int>(CollisionQueryStatistic::Count))
+		return 0;
+
+	return m_statistics[statistic];
+}
+
+const char* CollisionQueryBatcher::GetStatisticName(int statistic) const
+{
+	if (statistic < 0 || statistic >= static_cast<int>(CollisionQueryStatistic::Count))
+		return "";
+
+	return s_collisionQueryStatisticNames[statistic];
+}
+
+void CollisionQueryBatcher::ResetStatistics()
+{
+	std::fill(std::begin(m_statistics), std::end(m_statistics), 0);
+}
+
+} // namespace eqlib
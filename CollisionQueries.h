@@ -0,0 +1,176 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Common.h"
+#include "base/Primitives.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+// A line of sight test between two points. Positions use the same convention as the source
+// position passed to CastRayLoc. |race| selects the eye height used by the game.
+struct LineOfSightQuery
+{
+	CVector3 source;
+	CVector3 target;
+	EQRace   race = 0;
+};
+
+// Performs the actual collision tests for a CollisionQueryBatcher.
+class CollisionQueryBackend
+{
+public:
+	virtual ~CollisionQueryBackend() {}
+
+	// Returns true if nothing blocks the line between the query's source and target.
+	virtual bool HasLineOfSight(const LineOfSightQuery& query) = 0;
+};
+
+// Backend that asks the game, via CastRayLoc.
+class GameCollisionQueryBackend : public CollisionQueryBackend
+{
+public:
+	EQLIB_OBJECT virtual bool HasLineOfSight(const LineOfSightQuery& query) override;
+};
+
+enum class CollisionQueryStatistic
+{
+	Queries,             // queries submitted
+	Deduplicated,        // queries that repeated another query in the same batch
+	CacheHits,           // queries answered from the cache
+	BackendCalls,        // queries sent to the backend
+	Invalidated,         // cached results dropped by InvalidateNear/InvalidateAll
+	Expired,             // cached results that were too old to use
+
+	Count
+};
+
+// Batches and caches line of sight queries.
+//
+// Queries are submitted during a frame and resolved together by Execute. Queries that repeat
+// one already in the batch share its result, and queries whose endpoints are within the
+// position tolerance of a recent query reuse that result until it expires. Whatever is left is
+// sent to the backend in one tight loop.
+//
+// Cached results can also be dropped early around a point that changed, e.g. a door that
+// opened, with InvalidateNear.
+class CollisionQueryBatcher
+{
+public:
+	// Uses the game's collision when |backend| is null. The batcher does not take ownership.
+	EQLIB_OBJECT CollisionQueryBatcher(CollisionQueryBackend* backend = nullptr);
+
+	void SetBackend(CollisionQueryBackend* backend) { m_backend = backend; InvalidateAll(); }
+
+	// How long, in milliseconds, a result stays usable.
+	void SetCacheLifetime(uint32_t lifetimeMs) { m_cacheLifetime = lifetimeMs; }
+	uint32_t GetCacheLifetime() const { return m_cacheLifetime; }
+
+	// Endpoints that fall in the same cell of a grid with this spacing are treated as the same
+	// point. Changing it drops everything that is cached.
+	EQLIB_OBJECT void SetPositionTolerance(float tolerance);
+	float GetPositionTolerance() const { return m_tolerance; }
+
+	EQLIB_OBJECT void SetMaxCacheSize(size_t maxEntries);
+
+	// Adds a query to the current batch and returns a handle for its result. The result is
+	// available from GetResult after the next call to Execute.
+	EQLIB_OBJECT int Submit(const LineOfSightQuery& query);
+
+	// Resolves every query in the current batch. |currentTimeMs| is used to age the cache.
+	// Returns the number of queries that had to go to the backend.
+	EQLIB_OBJECT int Execute(uint32_t currentTimeMs);
+
+	// Result of a query from the last executed batch. Handles are invalidated by the next Submit
+	// after an Execute.
+	bool GetResult(int handle) const
+	{
+		return handle >= 0 && handle < static_cast<int>(m_results.size()) && m_results[handle] != 0;
+	}
+
+	size_t GetPendingCount() const { return m_pending.size(); }
+
+	// Resolves a single query immediately, using and updating the cache.
+	EQLIB_OBJECT bool HasLineOfSight(const LineOfSightQuery& query, uint32_t currentTimeMs);
+
+	// Drops cached results for lines that pass within |radius| of |position|.
+	EQLIB_OBJECT int InvalidateNear(const CVector3& position, float radius);
+	EQLIB_OBJECT void InvalidateAll();
+
+	size_t GetCacheSize() const { return m_cache.size(); }
+
+	// Counters, in the same form as CCollisionInterface::GetStatistic.
+	EQLIB_OBJECT uint32_t GetStatistic(int statistic) const;
+	EQLIB_OBJECT const char* GetStatisticName(int statistic) const;
+	EQLIB_OBJECT void ResetStatistics();
+
+private:
+	struct QuantizedKey
+	{
+		int32_t coords[6];
+		EQRace race;
+
+		bool operator==(const QuantizedKey& other) const
+		{
+			return race == other.race && memcmp(coords, other.coords, sizeof(coords)) == 0;
+		}
+	};
+
+	struct QuantizedKeyHash
+	{
+		size_t operator()(const QuantizedKey& key) const;
+	};
+
+	struct CacheEntry
+	{
+		CVector3 source;
+		CVector3 target;
+		uint32_t timestamp;
+		bool result;
+	};
+
+	QuantizedKey MakeKey(const LineOfSightQuery& query) const;
+	bool Resolve(const QuantizedKey& key, const LineOfSightQuery& query, uint32_t currentTimeMs);
+	void Trim(uint32_t currentTimeMs);
+
+	// Resolved on every call rather than pointing m_backend at m_gameBackend, so copies of the
+	// batcher don't end up using the original's game backend.
+	CollisionQueryBackend* GetBackend() { return m_backend ? m_backend : &m_gameBackend; }
+
+	GameCollisionQueryBackend m_gameBackend;
+	CollisionQueryBackend* m_backend;                // null for m_gameBackend
+
+	uint32_t m_cacheLifetime = 250;
+	float m_tolerance = 1.0f;
+	float m_inverseTolerance = 1.0f;
+	size_t m_maxCacheSize = 4096;
+
+	std::unordered_map<QuantizedKey, CacheEntry, QuantizedKeyHash> m_cache;
+
+	// The current batch. m_batchIndex maps each distinct query to its slot.
+	std::vector<LineOfSightQuery> m_pending;
+	std::vector<QuantizedKey> m_pendingKeys;
+	std::unordered_map<QuantizedKey, int, QuantizedKeyHash> m_batchIndex;
+	std::vector<uint8_t> m_results;
+	bool m_executed = false;
+
+	uint32_t m_statistics[static_cast<int>(CollisionQueryStatistic::Count)] = { 0 };
+};
+
+} // namespace eqlib
@@ -0,0 +1,193 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "ConnectionStats.h"
+
+namespace eqlib {
+
+using namespace UdpLibrary;
+
+static float PerSecond(int64_t delta, float seconds)
+{
+	return static_cast<float>(delta) / seconds;
+}
+
+static float Percent(int64_t part, int64_t total)
+{
+	return total > 0 ? 100.0f * static_cast<float>(part) / static_cast<float>(total) : 0.0f;
+}
+
+static void ComputeRates(const UdpConnectionSample& previous, UdpConnectionSample& sample)
+{
+	const UdpConnectionStatistics& now = sample.stats;
+	const UdpConnectionStatistics& before = previous.stats;
+
+	// Counters that went backwards mean a new connection, there's nothing to compare with.
+	if (sample.timestamp <= previous.timestamp
+		|| now.totalPacketsSent < before.totalPacketsSent
+		|| now.totalPacketsReceived < before.totalPacketsReceived)
+	{
+		return;
+	}
+
+	float seconds = static_cast<float>(sample.timestamp - previous.timestamp) / 1000.0f;
+
+	int64_t packetsSent = now.totalPacketsSent - before.totalPacketsSent;
+	int64_t packetsReceived = now.totalPacketsReceived - before.totalPacketsReceived;
+
+	sample.packetsSentPerSecond = PerSecond(packetsSent, seconds);
+	sample.packetsReceivedPerSecond = PerSecond(packetsReceived, seconds);
+	sample.bytesSentPerSecond = PerSecond(now.totalBytesSent - before.totalBytesSent, seconds);
+	sample.bytesReceivedPerSecond = PerSecond(now.totalBytesReceived - before.totalBytesReceived, seconds);
+
+	int64_t resent = (now.resentPacketsAccelerated - before.resentPacketsAccelerated)
+		+ (now.resentPacketsTimedOut - before.resentPacketsTimedOut);
+	sample.resendPercent = Percent(resent, packetsSent);
+	sample.outOfOrderPercent = Percent(now.outOfOrderPacketsReceived - before.outOfOrderPacketsReceived, packetsReceived);
+
+	// Same smoothing as RFC 3550 interarrival jitter, applied to successive ping times.
+	float difference = static_cast<float>(std::abs(now.lastPingTime - before.lastPingTime));
+	sample.jitter = previous.jitter + (difference - previous.jitter) / 16.0f;
+}
+
+//============================================================================
+// UdpConnectionSampler
+//============================================================================
+
+UdpConnectionSampler::UdpConnectionSampler(uint32_t intervalMs)
+	: m_intervalMs(intervalMs)
+{
+}
+
+bool UdpConnectionSampler::Pulse(UdpConnection* connection)
+{
+	if (!connection)
+		return false;
+
+	if (m_hasPrevious && GetTickCount64() - m_lastSampleTime < m_intervalMs)
+		return false;
+
+	Sample(connection);
+	return true;
+}
+
+void UdpConnectionSampler::Sample(UdpConnection* connection)
+{
+	if (!connection)
+		return;
+
+	UdpConnectionSample sample;
+	sample.timestamp = GetTickCount64();
+
+	UdpClockStamp lastReceiveTime;
+	{
+		UdpGuard udpGuard(&connection->m_guard);
+
+		sample.stats = connection->m_stats;
+		lastReceiveTime = connection->m_lastReceiveTime;
+	}
+
+	// This only needs the manager's clock guard, not the connection's.
+	sample.lastReceiveAge = connection->CachedClockElapsed(lastReceiveTime);
+
+	if (m_hasPrevious)
+		ComputeRates(m_previous, sample);
+
+	m_previous = sample;
+	m_hasPrevious = true;
+	m_lastSampleTime = sample.timestamp;
+
+	uint64_t sampleNumber = m_sampleCount.load(std::memory_order_relaxed);
+	Slot& slot = m_slots[sampleNumber % Capacity];
+
+	uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.sample = sample;
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+	m_sampleCount.store(sampleNumber + 1, std::memory_order_release);
+}
+
+void UdpConnectionSampler::Reset()
+{
+	m_hasPrevious = false;
+	m_lastSampleTime = 0;
+
+	m_firstSample.store(m_sampleCount.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+bool UdpConnectionSampler::ReadSlot(uint64_t sampleNumber, UdpConnectionSample& sample) const
+{
+	const Slot& slot = m_slots[sampleNumber % Capacity];
+
+	// Each slot is written once per trip around the ring, so the sequence tells which sample
+	// the slot holds as well as whether it's being written.
+	uint32_t expected = static_cast<uint32_t>((sampleNumber / Capacity + 1) * 2);
+
+	for (int attempt = 0; attempt < 16; ++attempt)
+	{
+		uint32_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before & 1)
+			continue;
+
+		if (before != expected)
+			return false;
+
+		sample = slot.sample;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == before)
+			return true;
+	}
+
+	return false;
+}
+
+bool UdpConnectionSampler::GetLatest(UdpConnectionSample& sample) const
+{
+	for (int attempt = 0; attempt < 4; ++attempt)
+	{
+		uint64_t count = m_sampleCount.load(std::memory_order_acquire);
+		if (count == 0 || count <= m_firstSample.load(std::memory_order_acquire))
+			return false;
+
+		if (ReadSlot(count - 1, sample))
+			return true;
+	}
+
+	return false;
+}
+
+size_t UdpConnectionSampler::GetHistory(UdpConnectionSample* samples, size_t maxSamples) const
+{
+	uint64_t count = m_sampleCount.load(std::memory_order_acquire);
+	uint64_t first = m_firstSample.load(std::memory_order_acquire);
+
+	uint64_t available = std::min<uint64_t>({ count - std::min(first, count), Capacity, maxSamples });
+
+	size_t copied = 0;
+	for (uint64_t sampleNumber = count - available; sampleNumber < count; ++sampleNumber)
+	{
+		// The oldest few may have been overwritten while we were copying.
+		if (ReadSlot(sampleNumber, samples[copied]))
+			++copied;
+	}
+
+	return copied;
+}
+
+} // namespace eqlib
@@ -0,0 +1,110 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "EQClasses.h"
+
+#include <array>
+#include <atomic>
+
+namespace eqlib {
+
+// One sample of a connection's statistics, and the rates derived from it and the sample
+// before it.
+struct UdpConnectionSample
+{
+	uint64_t timestamp = 0;                     // GetTickCount64 when the sample was taken
+	UdpLibrary::UdpConnectionStatistics stats = {};
+	int      lastReceiveAge = 0;                // ms since anything was received
+
+	// Rates over the time since the previous sample. Zero for the first sample.
+	float    packetsSentPerSecond = 0.0f;
+	float    packetsReceivedPerSecond = 0.0f;
+	float    bytesSentPerSecond = 0.0f;
+	float    bytesReceivedPerSecond = 0.0f;
+	float    resendPercent = 0.0f;              // resent packets as a percentage of packets sent
+	float    outOfOrderPercent = 0.0f;          // out of order packets as a percentage of packets received
+	float    jitter = 0.0f;                     // smoothed variation of the last ping time, in ms
+};
+
+// Samples a UdpConnection's statistics at a fixed interval into a time series.
+//
+// GetAveragePing, GetLastReceiveTime and friends each take the connection's guard, and reading
+// several of them takes it several times. The sampler copies the statistics and the receive
+// time under a single guard once per interval, works out the rates, and appends the result to
+// a fixed size ring.
+//
+// Only the thread that calls Pulse/Sample writes to the ring. Any thread can read it at any time
+// without a lock: every slot has a sequence number that is odd while the slot is being written,
+// and readers copy the slot and retry if the sequence changed underneath them.
+class UdpConnectionSampler
+{
+public:
+	static constexpr size_t Capacity = 256;
+
+	EQLIB_OBJECT UdpConnectionSampler(uint32_t intervalMs = 1000);
+
+	UdpConnectionSampler(const UdpConnectionSampler&) = delete;
+	UdpConnectionSampler& operator=(const UdpConnectionSampler&) = delete;
+
+	// Takes a sample if the interval has passed since the last one. Call this every frame.
+	// Returns true if a sample was taken.
+	EQLIB_OBJECT bool Pulse(UdpLibrary::UdpConnection* connection);
+
+	// Takes a sample now.
+	EQLIB_OBJECT void Sample(UdpLibrary::UdpConnection* connection);
+
+	// Forgets all samples. Only call this from the sampling thread, e.g. when the connection
+	// changes.
+	EQLIB_OBJECT void Reset();
+
+	void SetInterval(uint32_t intervalMs) { m_intervalMs = intervalMs; }
+	uint32_t GetInterval() const { return m_intervalMs; }
+
+	// Number of samples taken since the last Reset. The ring holds the last Capacity of them.
+	uint64_t GetSampleCount() const
+	{
+		return m_sampleCount.load(std::memory_order_acquire) - m_firstSample.load(std::memory_order_acquire);
+	}
+
+	// Copies the most recent sample. Returns false if there is none yet.
+	EQLIB_OBJECT bool GetLatest(UdpConnectionSample& sample) const;
+
+	// Copies up to |maxSamples| of the most recent samples into |samples|, oldest first. Returns
+	// the number copied.
+	EQLIB_OBJECT size_t GetHistory(UdpConnectionSample* samples, size_t maxSamples) const;
+
+private:
+	struct Slot
+	{
+		std::atomic<uint32_t> sequence{ 0 };
+		UdpConnectionSample   sample;
+	};
+
+	// Copies the sample with the given sample number. Returns false if it was overwritten.
+	bool ReadSlot(uint64_t sampleNumber, UdpConnectionSample& sample) const;
+
+	std::array<Slot, Capacity> m_slots;
+	std::atomic<uint64_t> m_sampleCount{ 0 };    // never goes down, so slot sequences stay valid
+	std::atomic<uint64_t> m_firstSample{ 0 };    // first sample number since the last Reset
+
+	// Only touched by the sampling thread.
+	UdpConnectionSample m_previous;
+	bool m_hasPrevious = false;
+	uint64_t m_lastSampleTime = 0;
+	uint32_t m_intervalMs;
+};
+
+} // namespace eqlib
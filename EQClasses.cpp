@@ -19,6 +19,8 @@
 #include "AltAbilities.h"
 #include "RealEstate.h"
 
+#include <unordered_map>
+
 #pragma warning(push)
 #pragma warning(disable:4740) // warning C4740: flow in or out of inline asm code suppresses global optimization
 #pragma warning(disable:4530) // warning C4530: c++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
@@ -29,20 +31,258 @@ namespace eqlib {
 // AchievementManager
 //============================================================================
 
+// Index over the achievement manager's data, kept outside of the manager since its layout is
+// owned by the game. The name and category indices depend only on the achievement definitions,
+// while the component counts also depend on the player's achievement state, so each half tracks
+// its own signature to know when it is stale.
+class AchievementIndex
+{
+public:
+	static AchievementIndex& Get(const AchievementManager& manager)
+	{
+		static AchievementIndex s_index;
+
+		s_index.Validate(manager);
+		return s_index;
+	}
+
+	void Invalidate()
+	{
+		m_definitionKey = DefinitionKey();
+		m_stateKey = StateKey();
+	}
+
+	int FindAchievement(std::string_view name) const { return Find(m_achievementsByName, name); }
+	int FindRootCategory(std::string_view name) const { return Find(m_rootCategoriesByName, name); }
+
+	const std::vector<int>& GetChildCategories(int categoryIndex) const
+	{
+		static const std::vector<int> s_empty;
+
+		if (categoryIndex < 0 || categoryIndex >= static_cast<int>(m_childCategories.size()))
+			return s_empty;
+
+		return m_childCategories[categoryIndex];
+	}
+
+	// Returns the counts of the components of the given type, or nullptr if the achievement
+	// is out of range. |outCount| receives the number of components.
+	const int* GetComponentCounts(int achievementIndex, AchievementComponentType type, int& outCount) const
+	{
+		outCount = 0;
+
+		if (achievementIndex < 0 || achievementIndex >= static_cast<int>(m_componentOffsets.size()) - 1
+			|| type < AchievementComponentUnlock || type >= AchievementComponentCount)
+		{
+			return nullptr;
+		}
+
+		const int* offsets = &m_componentOffsets[achievementIndex].offset[0];
+		outCount = offsets[type + 1] - offsets[type];
+		return m_componentCounts.data() + offsets[type];
+	}
+
+private:
+	struct DefinitionKey
+	{
+		const AchievementManager* manager = nullptr;
+		int achievementCount = -1;
+		int categoryCount = -1;
+		const Achievement* firstAchievement = nullptr;
+		const AchievementCategory* firstCategory = nullptr;
+
+		bool operator==(const DefinitionKey& other) const
+		{
+			return manager == other.manager
+				&& achievementCount == other.achievementCount
+				&& categoryCount == other.categoryCount
+				&& firstAchievement == other.firstAchievement
+				&& firstCategory == other.firstCategory;
+		}
+	};
+
+	struct StateKey
+	{
+		int clientInfoCount = -1;
+		bool statesSet = false;
+		uint32_t completedScore = 0;
+		uint32_t completedCount = 0;
+		uint32_t lockedCount = 0;
+		uint32_t openCount = 0;
+
+		bool operator==(const StateKey& other) const
+		{
+			return clientInfoCount == other.clientInfoCount
+				&& statesSet == other.statesSet
+				&& completedScore == other.completedScore
+				&& completedCount == other.completedCount
+				&& lockedCount == other.lockedCount
+				&& openCount == other.openCount;
+		}
+	};
+
+	struct ComponentOffsets
+	{
+		int offset[AchievementComponentCount + 1];
+	};
+
+	static void AppendLower(std::string& out, std::string_view str)
+	{
+		out.clear();
+		out.reserve(str.length());
+
+		for (char ch : str)
+			out.push_back(static_cast<char>(tolower(static_cast<uint8_t>(ch))));
+	}
+
+	int Find(const std::unordered_map<std::string, int>& map, std::string_view name) const
+	{
+		if (name.empty())
+			return -1;
+
+		AppendLower(m_lookupBuffer, name);
+
+		auto iter = map.find(m_lookupBuffer);
+		return iter != map.end() ? iter->second : -1;
+	}
+
+	void Validate(const AchievementManager& manager)
+	{
+		DefinitionKey definitionKey;
+		definitionKey.manager = &manager;
+		definitionKey.achievementCount = manager.achievements.GetLength();
+		definitionKey.categoryCount = manager.categories.GetLength();
+		definitionKey.firstAchievement = manager.GetAchievementByIndex(0);
+		definitionKey.firstCategory = manager.GetAchievementCategoryByIndex(0);
+
+		StateKey stateKey;
+		stateKey.clientInfoCount = manager.achievementClientInfoArray.GetLength();
+		stateKey.statesSet = manager.achievementClientStatesSet;
+		stateKey.completedScore = manager.completedAchievementScore;
+		stateKey.completedCount = manager.completedAchievementCount;
+		stateKey.lockedCount = manager.lockedAchievemmentCount;
+		stateKey.openCount = manager.openAchievementCount;
+
+		if (!(definitionKey == m_definitionKey))
+		{
+			BuildDefinitions(manager);
+			m_definitionKey = definitionKey;
+
+			// component counts are stored by achievement index, so those are stale too.
+			m_stateKey = StateKey();
+		}
+
+		if (!(stateKey == m_stateKey))
+		{
+			BuildComponentCounts(manager);
+			m_stateKey = stateKey;
+		}
+	}
+
+	void BuildDefinitions(const AchievementManager& manager)
+	{
+		std::string key;
+
+		m_achievementsByName.clear();
+		m_achievementsByName.reserve(manager.achievements.GetLength());
+
+		for (int index = 0; index < manager.achievements.GetLength(); ++index)
+		{
+			AppendLower(key, manager.achievements[index].name);
+
+			// first one wins, same as a linear search would.
+			m_achievementsByName.emplace(key, index);
+		}
+
+		m_rootCategoriesByName.clear();
+		m_childCategories.clear();
+		m_childCategories.resize(manager.categories.GetLength());
+
+		std::unordered_map<int, int> categoryIndexById;
+		categoryIndexById.reserve(manager.categories.GetLength());
+
+		for (int index = 0; index < manager.categories.GetLength(); ++index)
+		{
+			const AchievementCategory& category = manager.categories[index];
+			categoryIndexById.emplace(category.id, index);
+
+			if (category.parentId <= 0)
+			{
+				AppendLower(key, category.name);
+				m_rootCategoriesByName.emplace(key, index);
+			}
+		}
+
+		for (int index = 0; index < manager.categories.GetLength(); ++index)
+		{
+			const AchievementCategory& category = manager.categories[index];
+
+			for (int childId : category.childCategories)
+			{
+				auto iter = categoryIndexById.find(childId);
+				if (iter != categoryIndexById.end())
+					m_childCategories[index].push_back(iter->second);
+			}
+		}
+	}
+
+	void BuildComponentCounts(const AchievementManager& manager)
+	{
+		const int achievementCount = manager.achievements.GetLength();
+
+		m_componentOffsets.resize(achievementCount + 1);
+		m_componentCounts.clear();
+
+		for (int index = 0; index < achievementCount; ++index)
+		{
+			const Achievement& achievement = manager.achievements[index];
+			ComponentOffsets& offsets = m_componentOffsets[index];
+
+			for (int type = 0; type < AchievementComponentCount; ++type)
+			{
+				offsets.offset[type] = static_cast<int>(m_componentCounts.size());
+
+				for (const AchievementComponent& component : achievement.componentsByType[type])
+					m_componentCounts.push_back(component.count);
+			}
+
+			offsets.offset[AchievementComponentCount] = static_cast<int>(m_componentCounts.size());
+		}
+
+		// sentinel so that the achievement count can be derived from the offsets.
+		std::fill(std::begin(m_componentOffsets[achievementCount].offset),
+			std::end(m_componentOffsets[achievementCount].offset), static_cast<int>(m_componentCounts.size()));
+	}
+
+	DefinitionKey m_definitionKey;
+	StateKey m_stateKey;
+
+	std::unordered_map<std::string, int> m_achievementsByName;
+	std::unordered_map<std::string, int> m_rootCategoriesByName;
+	std::vector<std::vector<int>> m_childCategories;
+
+	std::vector<ComponentOffsets> m_componentOffsets;
+	std::vector<int> m_componentCounts;
+
+	mutable std::string m_lookupBuffer;
+};
+
 int AchievementManager::GetAchievementCategoryIndexByName(std::string_view name) const
 {
 	if (name.empty())
 		return -1;
 
-	for (int index = 0; index < categories.GetLength(); ++index)
-	{
-		const AchievementCategory& category = categories[index];
+	int index = AchievementIndex::Get(*this).FindRootCategory(name);
 
-		if (category.parentId <= 0 && mq::ci_equals(category.name, name))
-			return index;
+	// The index is keyed on the shape of the data, so double check a hit in case the data was
+	// replaced in place.
+	if (index != -1 && !mq::ci_equals(categories[index].name, name))
+	{
+		InvalidateAchievementIndex();
+		index = AchievementIndex::Get(*this).FindRootCategory(name);
 	}
 
-	return -1;
+	return index;
 }
 
 int AchievementManager::GetAchievementIndexByName(std::string_view name) const
@@ -50,15 +290,46 @@ int AchievementManager::GetAchievementIndexByName(std::string_view name) const
 	if (name.empty())
 		return -1;
 
-	for (int index = 0; index < achievements.GetLength(); ++index)
-	{
-		const Achievement& achievement = achievements[index];
+	int index = AchievementIndex::Get(*this).FindAchievement(name);
 
-		if (mq::ci_equals(achievement.name, name))
-			return index;
+	if (index != -1 && !mq::ci_equals(achievements[index].name, name))
+	{
+		InvalidateAchievementIndex();
+		index = AchievementIndex::Get(*this).FindAchievement(name);
 	}
 
-	return -1;
+	return index;
+}
+
+const std::vector<int>& AchievementManager::GetChildCategoryIndices(int categoryIndex) const
+{
+	return AchievementIndex::Get(*this).GetChildCategories(categoryIndex);
+}
+
+int AchievementManager::GetAchievementComponentCount(int achievementIndex, AchievementComponentType type,
+	int componentIndex) const
+{
+	int count = 0;
+	const int* counts = AchievementIndex::Get(*this).GetComponentCounts(achievementIndex, type, count);
+
+	if (!counts || componentIndex < 0 || componentIndex >= count)
+		return 0;
+
+	return counts[componentIndex];
+}
+
+void AchievementManager::InvalidateAchievementIndex() const
+{
+	AchievementIndex::Get(*this).Invalidate();
+}
+
+static void FillComponentCounts(ArrayClass<int>& outCounts, int numBits, const int* counts, int count)
+{
+	if (outCounts.GetLength() != numBits)
+		outCounts.SetLength(numBits);
+
+	for (int index = 0; index < count; ++index)
+		outCounts[index] = counts[index];
 }
 
 bool AchievementManager::FillAchievementComponentInfoWithCounts(
@@ -72,32 +343,24 @@ bool AchievementManager::FillAchievementComponentInfoWithCounts(
 	if (!achievement)
 		return false;
 
+	const AchievementIndex& index = AchievementIndex::Get(*this);
+	int count = 0;
+	const int* counts = nullptr;
+
 	outInfo.achievementState = clientInfo->achievementState;
 	outInfo.completionTimestamp = clientInfo->completionTimestamp;
 
 	outInfo.completionComponentStatusBitField = clientInfo->completionComponentStatusBitField;
-	outInfo.completionComponentCounts.SetLength(outInfo.completionComponentStatusBitField.GetNumBits());
-	for (int index = 0; index < achievement->componentsByType[AchievementComponentCompletion].GetLength(); ++index)
-	{
-		const AchievementComponent& component = achievement->componentsByType[AchievementComponentCompletion][index];
-		outInfo.completionComponentCounts[index] = component.count;
-	}
+	counts = index.GetComponentCounts(achievementIndex, AchievementComponentCompletion, count);
+	FillComponentCounts(outInfo.completionComponentCounts, outInfo.completionComponentStatusBitField.GetNumBits(), counts, count);
 
 	outInfo.indirectComponentStatusBitField = clientInfo->indirectComponentStatusBitField;
-	outInfo.indirectComponentCounts.SetLength(outInfo.indirectComponentStatusBitField.GetNumBits());
-	for (int index = 0; index < achievement->componentsByType[AchievementComponentIndirect].GetLength(); ++index)
-	{
-		const AchievementComponent& component = achievement->componentsByType[AchievementComponentIndirect][index];
-		outInfo.indirectComponentCounts[index] = component.count;
-	}
+	counts = index.GetComponentCounts(achievementIndex, AchievementComponentIndirect, count);
+	FillComponentCounts(outInfo.indirectComponentCounts, outInfo.indirectComponentStatusBitField.GetNumBits(), counts, count);
 
 	outInfo.unlockedComponentStatusBitField = clientInfo->unlockedComponentStatusBitField;
-	outInfo.unlockedComponentCounts.SetLength(outInfo.unlockedComponentStatusBitField.GetNumBits());
-	for (int index = 0; index < achievement->componentsByType[AchievementComponentUnlock].GetLength(); ++index)
-	{
-		const AchievementComponent& component = achievement->componentsByType[AchievementComponentUnlock][index];
-		outInfo.unlockedComponentCounts[index] = component.count;
-	}
+	counts = index.GetComponentCounts(achievementIndex, AchievementComponentUnlock, count);
+	FillComponentCounts(outInfo.unlockedComponentCounts, outInfo.unlockedComponentStatusBitField.GetNumBits(), counts, count);
 
 	return true;
 }
@@ -151,27 +414,107 @@ const char* CAltAbilityData::GetShortName2() const
 // AltAdvManager
 //============================================================================
 
-CAltAbilityData* AltAdvManager::GetOwnedAbilityFromGroupID(PcZoneClient* pc, int groupId)
+// Index of the abilities in a character's AA list by group id. Building it costs one GetAAById
+// per owned ability, so it is kept until the AA list itself changes. Checking for that is a
+// compare of the ability ids, which is far cheaper than the lookups it saves.
+//
+// Only ability ids are kept. The game can reload the AA table in place, which would leave
+// cached CAltAbilityData pointers dangling, so each lookup resolves its id with GetAAById.
+class OwnedAltAbilityIndex
 {
-	if (!pc)
-		return nullptr;
+public:
+	static OwnedAltAbilityIndex& Get(AltAdvManager* manager, const PcProfile* profile)
+	{
+		static OwnedAltAbilityIndex s_index;
 
-	PcProfile* pProfile = pc->GetCurrentPcProfile();
-	if (!pProfile)
-		return nullptr;
+		s_index.Validate(manager, profile);
+		return s_index;
+	}
+
+	CAltAbilityData* Find(int groupId)
+	{
+		auto iter = m_abilityIdsByGroupId.find(groupId);
+		if (iter == m_abilityIdsByGroupId.end())
+			return nullptr;
+
+		CAltAbilityData* pAbility = m_manager->GetAAById(iter->second);
+		if (pAbility && pAbility->GroupID == groupId)
+			return pAbility;
+
+		// The table changed underneath us, index it again.
+		Rebuild();
 
-	for (int i = 0; i < AA_CHAR_MAX_REAL; ++i)
+		iter = m_abilityIdsByGroupId.find(groupId);
+		return iter != m_abilityIdsByGroupId.end() ? m_manager->GetAAById(iter->second) : nullptr;
+	}
+
+private:
+	void Validate(AltAdvManager* manager, const PcProfile* profile)
 	{
-		if (CAltAbilityData* pAbility = GetAAById(pProfile->GetAlternateAbilityId(i)))
+		bool changed = manager != m_manager
+			|| profile != m_profile
+			|| manager->abilities != m_abilities;
+
+		for (int i = 0; i < AA_CHAR_MAX_REAL; ++i)
 		{
-			if (pAbility != nullptr && pAbility->GroupID == groupId)
+			int abilityId = profile->GetAlternateAbilityId(i);
+			if (abilityId != m_abilityIds[i])
 			{
-				return pAbility;
+				m_abilityIds[i] = abilityId;
+				changed = true;
 			}
 		}
+
+		if (changed)
+		{
+			m_manager = manager;
+			m_profile = profile;
+			m_abilities = manager->abilities;
+
+			Rebuild();
+		}
 	}
 
-	return nullptr;
+	void Rebuild()
+	{
+		m_abilityIdsByGroupId.clear();
+
+		for (int abilityId : m_abilityIds)
+		{
+			if (CAltAbilityData* pAbility = m_manager->GetAAById(abilityId))
+			{
+				// first one wins, same as a linear search of the list would.
+				m_abilityIdsByGroupId.emplace(pAbility->GroupID, abilityId);
+			}
+		}
+	}
+
+	AltAdvManager* m_manager = nullptr;
+	const PcProfile* m_profile = nullptr;
+	const HashTable<CAltAbilityData*>* m_abilities = nullptr;
+	int m_abilityIds[AA_CHAR_MAX_REAL] = { 0 };
+
+	std::unordered_map<int, int> m_abilityIdsByGroupId;
+};
+
+CAltAbilityData* AltAdvManager::GetOwnedAbilityFromGroupID(PcZoneClient* pc, int groupId)
+{
+	if (!pc)
+		return nullptr;
+
+	PcProfile* pProfile = pc->GetCurrentPcProfile();
+	if (!pProfile)
+		return nullptr;
+
+	return OwnedAltAbilityIndex::Get(this, pProfile).Find(groupId);
+}
+
+int AltAdvManager::GetOwnedAbilityRankFromGroupID(PcZoneClient* pc, int groupId)
+{
+	if (CAltAbilityData* pAbility = GetOwnedAbilityFromGroupID(pc, groupId))
+		return pAbility->CurrentRank;
+
+	return 0;
 }
 
 //============================================================================
@@ -250,19 +593,26 @@ bool MercenaryAbilitiesData::IsRequirementMet(const MercenaryAbilityReq& req) co
 
 	auto& mgr = MercenaryAlternateAdvancementManagerClient::Instance();
 
-	const int* entry = mgr.GetFirstMercenaryAbilityIdByGroupId(req.ReqGroupID);
-	while (entry)
+	// The owned ability for a group is its highest owned rank, which settles most checks.
+	if (const int* ownedAbilityId = mgr.MercenaryAbilitiesOwnedByGroupID.FindFirst(req.ReqGroupID))
 	{
-		const MercenaryAbilitiesData* mercAbility = mgr.GetMercenaryAbility(*entry);
-		// is this an ability that satisfies the requirement?
-		if (mercAbility && mercAbility->GroupRank >= req.ReqGroupRank)
+		const MercenaryAbilitiesData* ownedAbility = mgr.GetMercenaryAbility(*ownedAbilityId);
+		if (ownedAbility && ownedAbility->GroupRank >= req.ReqGroupRank)
+			return true;
+	}
+
+	// Otherwise check each rank that would satisfy the requirement. The group table is keyed
+	// by rank, so this is a lookup per rank rather than a walk of every ability in the group.
+	if (const MercenaryAbilityGroup* group = mgr.MercenaryAbilityGroups.FindFirst(req.ReqGroupID))
+	{
+		const int maxRank = static_cast<int>(group->size());
+
+		for (int rank = std::max(req.ReqGroupRank, 1); rank <= maxRank; ++rank)
 		{
-			// do we own this ability?
-			if (pLocalPC->GetMercenaryAbilityInfo(mercAbility->AbilityID) != nullptr)
+			const int* abilityId = group->FindFirst(rank);
+			if (abilityId && pLocalPC->GetMercenaryAbilityInfo(*abilityId) != nullptr)
 				return true;
 		}
-
-		entry = mgr.GetNextMercenaryAbilityIdByGroupId(entry);
 	}
 
 	// if we didn't find anything then the requirements aren't met.
@@ -348,21 +698,9 @@ const MercenaryAbilitiesData* MercenaryAlternateAdvancementManagerClient::GetFir
 
 	if (!ownedAbility)
 	{
-		// no owned ability. Need to find the first one.
-		const int* pAbilityId = group->GetFirst();
-		while (pAbilityId)
-		{
-			if (const MercenaryAbilitiesData* pAbility = GetMercenaryAbility(*pAbilityId))
-			{
-				if (pAbility->GroupRank == 1)
-				{
-					unOwnedAbility = pAbility;
-					break;
-				}
-			}
-
-			pAbilityId = group->GetNext(pAbilityId);
-		}
+		// no owned ability. The group is keyed by rank, so look up the first one directly.
+		if (const int* pAbilityId = group->FindFirst(1))
+			unOwnedAbility = GetMercenaryAbility(*pAbilityId);
 	}
 	else if (curRank < maxRanks)
 	{
@@ -26,6 +26,10 @@
 
 #include <limits>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #undef FindWindow
 #undef InsertMenuItem
 
@@ -1893,6 +1897,33 @@ public:
 
 		return diff > INT_MAX ? INT_MAX : static_cast<int>(diff);
 	}
+
+	// Reads a clock stamp that another thread updates under a guard, without taking the guard.
+	// An aligned 64-bit load can't tear on x64. On x86 a plain 64-bit read is two 32-bit loads,
+	// and the writer can be preempted between its two stores, so use cmpxchg8b instead: comparing
+	// with and exchanging 0 never changes the value, and returns all 64 bits atomically.
+	static UdpClockStamp ReadClockStamp(const UdpClockStamp& stamp)
+	{
+#if defined(_M_AMD64) || defined(__x86_64__)
+		return *static_cast<const volatile UdpClockStamp*>(&stamp);
+#elif defined(_MSC_VER)
+		return static_cast<UdpClockStamp>(_InterlockedCompareExchange64(
+			reinterpret_cast<volatile int64_t*>(const_cast<UdpClockStamp*>(&stamp)), 0, 0));
+#else
+		return __atomic_load_n(&stamp, __ATOMIC_ACQUIRE);
+#endif
+	}
+};
+
+// Clock values read together without taking any guards.
+struct UdpClockSnapshot
+{
+	UdpClockStamp cachedClock;
+	UdpClockStamp lastReceiveTime;
+	UdpClockStamp lastSendTime;
+
+	int GetLastReceiveTime() const { return UdpMisc::ClockDiff(lastReceiveTime, cachedClock); }
+	int GetLastSendTime() const { return UdpMisc::ClockDiff(lastSendTime, cachedClock); }
 };
 
 class [[offsetcomments]] UdpManager : public UdpGuardedRefCount
@@ -1909,6 +1940,13 @@ public:
 		return UdpMisc::ClockDiff(start, CachedClock());
 	}
 
+	// Same as CachedClock, but without entering m_cachedClockGuard. Good for status displays
+	// that poll many connections every frame.
+	UdpClockStamp CachedClockUnguarded() const
+	{
+		return UdpMisc::ReadClockStamp(m_cachedClock);
+	}
+
 protected:
 /*0x000*/ // vftable
 /*0x018*/ uint8_t                    Unknown0x0000[0x2f8 - 0x18];
@@ -1951,9 +1989,28 @@ public:
 		return m_stats.averagePingTime;
 	}
 
+	// Reads the cached clock and the last send and receive times without entering any guard.
+	UdpClockSnapshot GetClockSnapshot() const
+	{
+		UdpClockSnapshot snapshot;
+		snapshot.lastReceiveTime = UdpMisc::ReadClockStamp(m_lastReceiveTime);
+		snapshot.lastSendTime = UdpMisc::ReadClockStamp(m_lastSendTime);
+
+		// Read the clock last, so it is never older than the stamps it is compared with.
+		snapshot.cachedClock = m_udpManager ? m_udpManager->CachedClockUnguarded()
+			: UdpMisc::ReadClockStamp(m_disconnectTime);
+		return snapshot;
+	}
+
+	int GetLastReceiveTimeUnguarded() const
+	{
+		return GetClockSnapshot().GetLastReceiveTime();
+	}
+
 	float GetConnectionStrength() const
 	{
-		int f = std::max<int>(GetLastReceiveTime() - 500, 0);
+		// Only needs the receive time, which doesn't need to be read under the guards.
+		int f = std::max<int>(GetLastReceiveTimeUnguarded() - 500, 0);
 		return 1.0f - static_cast<float>(f) / 180000;
 	}
 
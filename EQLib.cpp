@@ -54,6 +54,7 @@ void InitializeEQLib()
 	eqFree_ = eqFreeImpl;
 
 	InitializeGlobals();
+	UseNativeBufferCRC(true);
 
 	InitializeUI();
 	InitializeCXWnd();
@@ -64,6 +65,9 @@ void InitializeEQLibForTesting()
 {
 	eqAlloc_ = malloc;
 	eqFree_ = free;
+
+	// No game to compare against here.
+	UseNativeBufferCRC(false);
 }
 
 void ShutdownEQLib()
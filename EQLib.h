@@ -28,6 +28,7 @@
 
 // Globals that are used throughout the eqlib project
 #include "Globals.h"
+#include "OffsetCache.h"
 
 // Data structures and class definitions, broken up by topic. If any of these
 // gets too large, or has too many unrelated components, they should probably
@@ -38,6 +39,7 @@
 #include "Containers.h"
 #include "CXStr.h"
 #include "SoeUtil.h"
+#include "IniCache.h"
 
 // data structures - old headers. Eventually these will be consolidated
 #include "EQUIStructs.h"
@@ -46,6 +48,7 @@
 
 // ui components
 #include "ChatFilters.h"
+#include "ChatDispatch.h"
 #include "CXWnd.h"
 #include "UI.h"
 #include "XMLData.h"
@@ -54,17 +57,28 @@
 
 // game components
 #include "EverQuest.h"
+#include "WorldMessages.h"
+#include "ConnectionStats.h"
 #include "Achievements.h"
 #include "AltAbilities.h"
 #include "Items.h"
+#include "ItemCatalog.h"
 #include "PlayerClient.h"
 #include "PcClient.h"
+#include "RosterIndex.h"
+#include "ExtendedTargetTracker.h"
+#include "AggroSnapshot.h"
 #include "RealEstate.h"
+#include "RealEstateIndex.h"
 #include "Spells.h"
+#include "AffectTracker.h"
+#include "SpellStacking.h"
+#include "FocusCalculator.h"
 
 // misc components
 #include "GraphicsEngine.h"
 #include "GraphicsResources.h"
+#include "CollisionQueries.h"
 #include "LoginFrontend.h"
 #include "ItemLinks.h"
 
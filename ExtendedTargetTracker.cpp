@@ -0,0 +1,309 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "ExtendedTargetTracker.h"
+
+namespace eqlib {
+
+// The aggro meter has readings for this many extended target slots, starting at AD_xTarget1.
+constexpr int NUM_AGGRO_XTARGETS = AD_xTarget20 - AD_xTarget1 + 1;
+
+static bool IsTargetSlotOccupied(const ExtendedTargetSlot& target)
+{
+	return target.SpawnID != 0;
+}
+
+static bool IsHaterSlot(const ExtendedTargetSlot& target)
+{
+	return IsTargetSlotOccupied(target) && target.xTargetType == XTARGET_AUTO_HATER;
+}
+
+ExtendedTargetTracker::ExtendedTargetTracker()
+{
+}
+
+int ExtendedTargetTracker::Subscribe(Callback callback)
+{
+	int id = m_nextSubscriptionId++;
+
+	// Subscribers added by a callback start with the next Update.
+	if (m_notifying)
+		m_pendingSubscriptions.push_back(Subscription{ id, std::move(callback) });
+	else
+		m_subscriptions.push_back(Subscription{ id, std::move(callback) });
+
+	return id;
+}
+
+void ExtendedTargetTracker::Unsubscribe(int subscriptionId)
+{
+	auto matches = [subscriptionId](const Subscription& s) { return s.id == subscriptionId; };
+
+	m_pendingSubscriptions.erase(std::remove_if(m_pendingSubscriptions.begin(), m_pendingSubscriptions.end(), matches),
+		m_pendingSubscriptions.end());
+
+	if (m_notifying)
+	{
+		// The list is being walked, so only mark it. It is removed once the walk is done.
+		auto iter = std::find_if(m_subscriptions.begin(), m_subscriptions.end(), matches);
+		if (iter != m_subscriptions.end())
+			iter->id = 0;
+	}
+	else
+	{
+		m_subscriptions.erase(std::remove_if(m_subscriptions.begin(), m_subscriptions.end(), matches), m_subscriptions.end());
+	}
+}
+
+void ExtendedTargetTracker::Reset()
+{
+	// Can't drop the events while they're being delivered, it happens when they're done.
+	if (m_notifying)
+	{
+		m_resetPending = true;
+		return;
+	}
+
+	m_snapshot.clear();
+	m_changes.clear();
+	m_slotsBySpawn.clear();
+	m_haterSlots.clear();
+	m_haterCount = 0;
+	m_aggroPct.clear();
+	m_aggroView.clear();
+	m_aggroViewDirty = false;
+}
+
+void ExtendedTargetTracker::Notify()
+{
+	m_notifying = true;
+
+	// Indexes rather than iterators: nothing is added to or removed from either list until the
+	// walk is done, but callbacks may mark subscriptions as removed.
+	for (size_t change = 0; change < m_changes.size(); ++change)
+	{
+		for (size_t index = 0; index < m_subscriptions.size(); ++index)
+		{
+			if (m_subscriptions[index].id != 0)
+				m_subscriptions[index].callback(m_changes[change]);
+		}
+	}
+
+	m_notifying = false;
+
+	m_subscriptions.erase(std::remove_if(m_subscriptions.begin(), m_subscriptions.end(),
+		[](const Subscription& s) { return s.id == 0; }), m_subscriptions.end());
+
+	for (Subscription& subscription : m_pendingSubscriptions)
+		m_subscriptions.push_back(std::move(subscription));
+	m_pendingSubscriptions.clear();
+
+	if (m_resetPending)
+	{
+		m_resetPending = false;
+		Reset();
+	}
+}
+
+void ExtendedTargetTracker::Publish(ExtendedTargetChangeType type, int slot, const ExtendedTargetSlot& target)
+{
+	m_changes.push_back(ExtendedTargetChangeEvent{ type, slot, target.SpawnID, target.xTargetType });
+}
+
+void ExtendedTargetTracker::AddToIndex(int slot, const ExtendedTargetSlot& target)
+{
+	std::vector<int>& slots = m_slotsBySpawn[target.SpawnID];
+	slots.insert(std::lower_bound(slots.begin(), slots.end(), slot), slot);
+
+	m_aggroViewDirty = true;
+}
+
+void ExtendedTargetTracker::RemoveFromIndex(int slot, const ExtendedTargetSlot& target)
+{
+	auto iter = m_slotsBySpawn.find(target.SpawnID);
+	if (iter != m_slotsBySpawn.end())
+	{
+		std::vector<int>& slots = iter->second;
+		slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+
+		if (slots.empty())
+			m_slotsBySpawn.erase(iter);
+	}
+
+	m_aggroViewDirty = true;
+}
+
+int ExtendedTargetTracker::Update(const ExtendedTargetList& list, const AggroMeterManagerClient* aggro)
+{
+	// A callback can't update the tracker while it's delivering the events of this update.
+	if (m_notifying)
+		return 0;
+
+	m_changes.clear();
+
+	int numSlots = list.GetNumSlots();
+	const ExtendedTargetSlot* current = list.cbegin();
+
+	int previousSlots = static_cast<int>(m_snapshot.size());
+	if (numSlots > previousSlots)
+	{
+		// New slots start out empty, so anything in them is reported as added.
+		ExtendedTargetSlot empty = {};
+
+		m_snapshot.resize(numSlots, empty);
+		m_haterSlots.resize(numSlots, false);
+		m_aggroPct.resize(numSlots, -1);
+	}
+
+	for (int slot = 0; slot < static_cast<int>(m_snapshot.size()); ++slot)
+	{
+		ExtendedTargetSlot& previous = m_snapshot[slot];
+
+		// The list shrank: whatever was in the slots that went away is gone.
+		if (slot >= numSlots)
+		{
+			if (IsTargetSlotOccupied(previous))
+			{
+				RemoveFromIndex(slot, previous);
+				Publish(ExtendedTargetChangeType::Removed, slot, previous);
+			}
+
+			continue;
+		}
+
+		// Most slots don't change from one frame to the next.
+		if (memcmp(&previous, &current[slot], sizeof(ExtendedTargetSlot)) == 0)
+			continue;
+
+		const ExtendedTargetSlot& now = current[slot];
+		bool wasOccupied = IsTargetSlotOccupied(previous);
+		bool isOccupied = IsTargetSlotOccupied(now);
+
+		if (wasOccupied && (!isOccupied || previous.SpawnID != now.SpawnID))
+		{
+			RemoveFromIndex(slot, previous);
+			Publish(ExtendedTargetChangeType::Removed, slot, previous);
+		}
+
+		if (isOccupied && (!wasOccupied || previous.SpawnID != now.SpawnID))
+		{
+			AddToIndex(slot, now);
+			Publish(ExtendedTargetChangeType::Added, slot, now);
+		}
+		else if (isOccupied)
+		{
+			if (previous.xTargetType != now.xTargetType)
+				Publish(ExtendedTargetChangeType::RoleChanged, slot, now);
+			else if (previous.XTargetSlotStatus != now.XTargetSlotStatus)
+				Publish(ExtendedTargetChangeType::StatusChanged, slot, now);
+		}
+
+		bool isHater = IsHaterSlot(now);
+		if (isHater != m_haterSlots[slot])
+		{
+			m_haterSlots[slot] = isHater;
+			m_haterCount += isHater ? 1 : -1;
+		}
+
+		memcpy(&previous, &now, sizeof(ExtendedTargetSlot));
+	}
+
+	if (numSlots < previousSlots)
+	{
+		for (int slot = numSlots; slot < previousSlots; ++slot)
+		{
+			if (m_haterSlots[slot])
+				--m_haterCount;
+		}
+
+		m_snapshot.resize(numSlots);
+		m_haterSlots.resize(numSlots);
+		m_aggroPct.resize(numSlots);
+	}
+
+	if (aggro && UpdateAggro(*aggro))
+		m_aggroViewDirty = true;
+
+	if (m_aggroViewDirty)
+		SortAggroView();
+
+	int numChanges = static_cast<int>(m_changes.size());
+	Notify();
+
+	return numChanges;
+}
+
+bool ExtendedTargetTracker::UpdateAggro(const AggroMeterManagerClient& aggro)
+{
+	bool changed = false;
+
+	int count = std::min(static_cast<int>(m_aggroPct.size()), NUM_AGGRO_XTARGETS);
+	for (int slot = 0; slot < count; ++slot)
+	{
+		int pct = aggro.aggroData[AD_xTarget1 + slot].AggroPct;
+		if (m_aggroPct[slot] != pct)
+		{
+			m_aggroPct[slot] = pct;
+
+			// Readings for empty slots don't show up in the view.
+			if (IsTargetSlotOccupied(m_snapshot[slot]))
+				changed = true;
+		}
+	}
+
+	return changed;
+}
+
+void ExtendedTargetTracker::SortAggroView()
+{
+	m_aggroView.clear();
+
+	for (int slot = 0; slot < static_cast<int>(m_snapshot.size()); ++slot)
+	{
+		if (IsTargetSlotOccupied(m_snapshot[slot]))
+			m_aggroView.push_back(ExtendedTargetAggro{ slot, m_snapshot[slot].SpawnID, m_aggroPct[slot] });
+	}
+
+	std::stable_sort(m_aggroView.begin(), m_aggroView.end(),
+		[](const ExtendedTargetAggro& a, const ExtendedTargetAggro& b) { return a.aggroPct > b.aggroPct; });
+
+	m_aggroViewDirty = false;
+}
+
+int ExtendedTargetTracker::GetSlotForSpawn(uint32_t spawnId) const
+{
+	auto iter = m_slotsBySpawn.find(spawnId);
+	if (iter == m_slotsBySpawn.end() || iter->second.empty())
+		return -1;
+
+	return iter->second.front();
+}
+
+bool ExtendedTargetTracker::IsHater(uint32_t spawnId) const
+{
+	auto iter = m_slotsBySpawn.find(spawnId);
+	if (iter == m_slotsBySpawn.end())
+		return false;
+
+	for (int slot : iter->second)
+	{
+		if (m_haterSlots[slot])
+			return true;
+	}
+
+	return false;
+}
+
+} // namespace eqlib
@@ -0,0 +1,133 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "EQClasses.h"
+#include "PcClient.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+enum class ExtendedTargetChangeType : uint8_t
+{
+	Added,               // a spawn appeared in a slot
+	Removed,             // a spawn left a slot
+	RoleChanged,         // same spawn, but the slot's type (auto hater, group assist...) changed
+	StatusChanged,       // same spawn, but it moved to or from the current zone
+};
+
+struct ExtendedTargetChangeEvent
+{
+	ExtendedTargetChangeType type;
+	int                      slot;
+	uint32_t                 spawnId;
+	uint32_t                 xTargetType;          // XTargetTypes, after the change
+};
+
+// An occupied extended target slot and its aggro meter reading.
+struct ExtendedTargetAggro
+{
+	int                      slot;
+	uint32_t                 spawnId;
+	int                      aggroPct;             // -1 if the aggro meter has no entry for the slot
+};
+
+// Tracks changes to the extended target list between frames.
+//
+// Works like AffectTracker: every Update copies the slot array and compares it with the copy
+// from the previous Update, and only slots whose bytes differ produce events. The tracker keeps
+// a spawn id -> slots index and the set of auto hater slots up to date, so "is this spawn on my
+// extended targets" and "how many haters do I have" don't need a scan.
+//
+// When given the aggro meter, Update also reads its per extended target readings and keeps a
+// view of the occupied slots sorted by aggro, highest first. It is only sorted again when a
+// reading or the set of occupied slots changed.
+class ExtendedTargetTracker
+{
+public:
+	using Callback = std::function<void(const ExtendedTargetChangeEvent&)>;
+
+	EQLIB_OBJECT ExtendedTargetTracker();
+
+	// Diffs |list| against the previous call, and notifies subscribers. |aggro| may be null, in
+	// which case the aggro view is left as it was. Returns the number of events.
+	EQLIB_OBJECT int Update(const ExtendedTargetList& list, const AggroMeterManagerClient* aggro = nullptr);
+
+	// Forgets the previous snapshot. The next Update reports every occupied slot as added.
+	EQLIB_OBJECT void Reset();
+
+	// Events produced by the last Update.
+	const std::vector<ExtendedTargetChangeEvent>& GetChanges() const { return m_changes; }
+
+	// Subscribers are called for every event, in slot order, during Update. Callbacks may
+	// subscribe, unsubscribe and reset: new subscribers get events from the next Update, and a
+	// reset happens after the remaining events are delivered. Calling Update from a callback does
+	// nothing.
+	EQLIB_OBJECT int Subscribe(Callback callback);
+	EQLIB_OBJECT void Unsubscribe(int subscriptionId);
+
+	// Returns the lowest slot holding |spawnId|, or -1.
+	EQLIB_OBJECT int GetSlotForSpawn(uint32_t spawnId) const;
+	bool IsOnExtendedTargets(uint32_t spawnId) const { return GetSlotForSpawn(spawnId) != -1; }
+
+	// Auto hater slots that hold a spawn.
+	EQLIB_OBJECT bool IsHater(uint32_t spawnId) const;
+	int GetHaterCount() const { return m_haterCount; }
+
+	// Occupied slots sorted by aggro, highest first. Ties are in slot order.
+	const std::vector<ExtendedTargetAggro>& GetAggroView() const { return m_aggroView; }
+
+	// The snapshot from the last Update.
+	int GetSlotCount() const { return static_cast<int>(m_snapshot.size()); }
+	const ExtendedTargetSlot* GetSnapshot(int slot) const
+	{
+		return slot >= 0 && slot < static_cast<int>(m_snapshot.size()) ? &m_snapshot[slot] : nullptr;
+	}
+
+private:
+	void AddToIndex(int slot, const ExtendedTargetSlot& target);
+	void RemoveFromIndex(int slot, const ExtendedTargetSlot& target);
+	void Publish(ExtendedTargetChangeType type, int slot, const ExtendedTargetSlot& target);
+	bool UpdateAggro(const AggroMeterManagerClient& aggro);
+	void SortAggroView();
+	void Notify();
+
+	std::vector<ExtendedTargetSlot> m_snapshot;
+	std::vector<ExtendedTargetChangeEvent> m_changes;
+
+	std::unordered_map<uint32_t, std::vector<int>> m_slotsBySpawn;   // sorted slots
+	std::vector<bool> m_haterSlots;
+	int m_haterCount = 0;
+
+	std::vector<int> m_aggroPct;                                     // by slot, -1 for none
+	std::vector<ExtendedTargetAggro> m_aggroView;
+	bool m_aggroViewDirty = false;
+
+	struct Subscription
+	{
+		int id;
+		Callback callback;
+	};
+	std::vector<Subscription> m_subscriptions;                       // id 0 if removed during Notify
+	std::vector<Subscription> m_pendingSubscriptions;                // added during Notify
+	int m_nextSubscriptionId = 1;
+	bool m_notifying = false;
+	bool m_resetPending = false;
+};
+
+} // namespace eqlib
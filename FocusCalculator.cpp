@@ -0,0 +1,161 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "FocusCalculator.h"
+
+#include "EQLib.h"
+
+namespace eqlib {
+
+static void HashValue(uint64_t& hash, uint64_t value)
+{
+	// FNV-1a, a word at a time. Good enough to tell one loadout from the next.
+	hash ^= value;
+	hash *= 0x100000001b3ull;
+}
+
+uint64_t FocusCalculator::ComputeStateSignature(CharacterZoneClient& character)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	const ItemContainer& possessions = character.GetItemPossessions();
+	for (int slot = InvSlot_FirstWornItem; slot <= InvSlot_LastWornItem; ++slot)
+	{
+		ItemRef pItem = possessions.GetItemRef(slot);
+		if (!pItem)
+		{
+			HashValue(hash, 0);
+			continue;
+		}
+
+		HashValue(hash, reinterpret_cast<uintptr_t>(pItem));
+		HashValue(hash, pItem->GetID());
+
+		pItem->GetHeldItems().VisitItemRefs(0, [&hash](ItemRef pAugment, const ItemIndex&)
+			{
+				HashValue(hash, reinterpret_cast<uintptr_t>(pAugment));
+				HashValue(hash, pAugment->GetID());
+			});
+	}
+
+	int numEffects = std::min(character.GetMaxEffects(), MAX_TOTAL_BUFFS);
+	HashValue(hash, numEffects);
+
+	for (int slot = 0; slot < numEffects; ++slot)
+	{
+		const EQ_Affect& affect = character.GetEffect(slot);
+		if (affect.SpellID <= 0)
+		{
+			HashValue(hash, 0);
+			continue;
+		}
+
+		// Limited use focus effects count down their hits.
+		HashValue(hash, (static_cast<uint64_t>(static_cast<uint32_t>(affect.SpellID)) << 32) | static_cast<uint32_t>(affect.HitCount));
+		HashValue(hash, affect.Level);
+	}
+
+	return hash;
+}
+
+FocusCalculator::FocusCalculator()
+{
+}
+
+void FocusCalculator::Invalidate()
+{
+	m_modifiers.clear();
+	m_character = nullptr;
+	m_signature = 0;
+	++m_invalidations;
+}
+
+bool FocusCalculator::Refresh(CharacterZoneClient& character)
+{
+	uint64_t signature = ComputeStateSignature(character);
+	int spellFileCRC = pSpellMgr ? pSpellMgr->SpellFileCRC : 0;
+
+	if (m_character == &character && m_signature == signature && m_spellFileCRC == spellFileCRC)
+		return false;
+
+	Invalidate();
+
+	m_character = &character;
+	m_signature = signature;
+	m_spellFileCRC = spellFileCRC;
+	return true;
+}
+
+const SpellFocusModifiers* FocusCalculator::Lookup(CharacterZoneClient& character, int spellId)
+{
+	auto iter = m_modifiers.find(spellId);
+	if (iter != m_modifiers.end())
+	{
+		++m_hits;
+		return &iter->second;
+	}
+
+	if (!pSpellMgr)
+		return nullptr;
+
+	EQ_Spell* pSpell = pSpellMgr->GetSpellByID(spellId);
+	if (!pSpell || pSpell->ID != spellId)
+		return nullptr;
+
+	++m_misses;
+
+	SpellFocusModifiers modifiers;
+	modifiers.spellId = spellId;
+
+	// Only the values are wanted, so keep the game from using up limited focus effects.
+	ItemPtr pItem;
+	modifiers.castingTime = character.GetFocusCastingTimeModifier(pSpell, pItem, true);
+	modifiers.reuse = character.GetFocusReuseMod(pSpell, pItem, true);
+	modifiers.range = character.GetFocusRangeModifier(pSpell, pItem);
+
+	return &m_modifiers.emplace(spellId, modifiers).first->second;
+}
+
+const SpellFocusModifiers* FocusCalculator::GetModifiers(CharacterZoneClient& character, int spellId)
+{
+	Refresh(character);
+
+	return Lookup(character, spellId);
+}
+
+int FocusCalculator::Evaluate(CharacterZoneClient& character, const int* spellIds, int numSpells,
+	SpellFocusModifiers* modifiers)
+{
+	Refresh(character);
+
+	uint32_t misses = m_misses;
+
+	for (int i = 0; i < numSpells; ++i)
+	{
+		if (const SpellFocusModifiers* result = Lookup(character, spellIds[i]))
+		{
+			modifiers[i] = *result;
+		}
+		else
+		{
+			modifiers[i] = SpellFocusModifiers();
+			modifiers[i].spellId = spellIds[i];
+		}
+	}
+
+	return static_cast<int>(m_misses - misses);
+}
+
+} // namespace eqlib
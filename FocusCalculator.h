@@ -0,0 +1,88 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Spells.h"
+
+#include <unordered_map>
+
+namespace eqlib {
+
+class CharacterZoneClient;
+
+// The focus modifiers that apply to a spell, as reported by the game.
+struct SpellFocusModifiers
+{
+	int spellId = 0;
+	int castingTime = 0;       // GetFocusCastingTimeModifier
+	int reuse = 0;             // GetFocusReuseMod
+	int range = 0;             // GetFocusRangeModifier
+};
+
+// Evaluates and remembers the focus modifiers that apply to spells.
+//
+// Asking the game for a spell's focus modifiers means walking the worn items and effects for
+// every modifier of every spell. The results only change when the equipment or the effects
+// do, so the calculator keeps them, keyed by spell, along with a signature of the worn items
+// (and their augments) and the effects they were computed with. The signature is taken once
+// per call, and the results are dropped whenever it changes.
+//
+// A new spell file drops the results too. The game's own focus caches (SpellCache) are left out
+// of the signature, since the game fills them lazily as spells are cast. Other changes, such as
+// buying an AA that adds a focus, need a call to Invalidate.
+class FocusCalculator
+{
+public:
+	EQLIB_OBJECT FocusCalculator();
+
+	// Returns the modifiers for one spell, or nullptr if the spell doesn't exist.
+	EQLIB_OBJECT const SpellFocusModifiers* GetModifiers(CharacterZoneClient& character, int spellId);
+
+	// Fills |modifiers| with the modifiers for each of |spellIds|, checking the signature only
+	// once for the whole set. Unknown spells get zeroed modifiers. Returns the number of spells
+	// that had to be evaluated by the game.
+	EQLIB_OBJECT int Evaluate(CharacterZoneClient& character, const int* spellIds, int numSpells,
+		SpellFocusModifiers* modifiers);
+
+	// Re-checks the signature, dropping cached results if it changed. Returns true if it did.
+	EQLIB_OBJECT bool Refresh(CharacterZoneClient& character);
+
+	EQLIB_OBJECT void Invalidate();
+
+	size_t GetCachedCount() const { return m_modifiers.size(); }
+	uint64_t GetStateSignature() const { return m_signature; }
+
+	uint32_t GetHitCount() const { return m_hits; }
+	uint32_t GetMissCount() const { return m_misses; }
+	uint32_t GetInvalidationCount() const { return m_invalidations; }
+
+	// Hashes everything the focus modifiers depend on that can be seen cheaply: the worn items
+	// and their augments, the effects, and the size of the game's focus caches.
+	EQLIB_OBJECT static uint64_t ComputeStateSignature(CharacterZoneClient& character);
+
+private:
+	const SpellFocusModifiers* Lookup(CharacterZoneClient& character, int spellId);
+
+	std::unordered_map<int, SpellFocusModifiers> m_modifiers;
+	CharacterZoneClient* m_character = nullptr;
+	uint64_t m_signature = 0;
+	int m_spellFileCRC = 0;
+
+	uint32_t m_hits = 0;
+	uint32_t m_misses = 0;
+	uint32_t m_invalidations = 0;
+};
+
+} // namespace eqlib
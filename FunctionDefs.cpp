@@ -1614,7 +1614,7 @@ FUNCTION_AT_ADDRESS(void, FlushDxKeyboard(), __FlushDxKeyboard);
 FUNCTION_AT_ADDRESS(bool, CopyLayout(const CXStr& currlayout, const CXStr& newlayout, bool bHotbuttons, bool bLoadouts, bool bSocials, CXStr& ErrorOut, bool bForceReload), __CopyLayout);
 #endif
 
-FUNCTION_AT_ADDRESS(uint32_t, GetBufferCRC(const char* szBuffer, size_t bufferLength, int baseValue), __MemChecker1);
+FUNCTION_AT_ADDRESS(uint32_t, EQGetBufferCRC(const char* szBuffer, size_t bufferLength, int baseValue), __MemChecker1);
 
 //============================================================================
 // Function Addresses: EverQuest
@@ -378,643 +378,689 @@ MQColor gDefaultUserDefinedColors[NUM_USER_COLORS] = {
 //
 // eqgame.exe Offsets
 
-INITIALIZE_EQGAME_OFFSET(__ActualVersionBuild);
-INITIALIZE_EQGAME_OFFSET(__ActualVersionDate);
-INITIALIZE_EQGAME_OFFSET(__ActualVersionTime);
-INITIALIZE_EQGAME_OFFSET(__BindList);
-INITIALIZE_EQGAME_OFFSET(__ChatFilterDefs);
-INITIALIZE_EQGAME_OFFSET(__CommandList);
-INITIALIZE_EQGAME_OFFSET(__CurrentMapLabel);
-INITIALIZE_EQGAME_OFFSET(__CurrentSocial);
-INITIALIZE_EQGAME_OFFSET(__do_loot);
-INITIALIZE_EQGAME_OFFSET(__gpbCommandEvent);
-INITIALIZE_EQGAME_OFFSET(__Guilds);
-INITIALIZE_EQGAME_OFFSET(__gWorld);
-INITIALIZE_EQGAME_OFFSET(__heqmain);
-INITIALIZE_EQGAME_OFFSET(__HWnd);
-INITIALIZE_EQGAME_OFFSET(__LabelCache);
-INITIALIZE_EQGAME_OFFSET(__LoginName);
-INITIALIZE_EQGAME_OFFSET(__MemCheckBitmask);
-INITIALIZE_EQGAME_OFFSET(__MemCheckActive);
-INITIALIZE_EQGAME_OFFSET(__Mouse);
-INITIALIZE_EQGAME_OFFSET(__MouseEventTime);
-INITIALIZE_EQGAME_OFFSET(__ScreenMode);
-INITIALIZE_EQGAME_OFFSET(__ServerHost);
-INITIALIZE_EQGAME_OFFSET(__ThrottleFrameRate);
-INITIALIZE_EQGAME_OFFSET(__ThrottleFrameRateEnd);
-INITIALIZE_EQGAME_OFFSET(EQObject_Top);
-INITIALIZE_EQGAME_OFFSET(g_eqCommandStates);
-INITIALIZE_EQGAME_OFFSET(instCRaid);
-INITIALIZE_EQGAME_OFFSET(instDynamicZone);
-INITIALIZE_EQGAME_OFFSET(instTribute);
-INITIALIZE_EQGAME_OFFSET(instEQZoneInfo);
-INITIALIZE_EQGAME_OFFSET(instExpeditionLeader);
-INITIALIZE_EQGAME_OFFSET(instExpeditionName);
-INITIALIZE_EQGAME_OFFSET(instTributeActive);
-INITIALIZE_EQGAME_OFFSET(pinstActiveBanker);
-INITIALIZE_EQGAME_OFFSET(pinstActiveCorpse);
-INITIALIZE_EQGAME_OFFSET(pinstActiveGMaster);
-INITIALIZE_EQGAME_OFFSET(pinstActiveMerchant);
-INITIALIZE_EQGAME_OFFSET(pinstAltAdvManager);
-INITIALIZE_EQGAME_OFFSET(pinstCamActor);
-INITIALIZE_EQGAME_OFFSET(pinstCChatWindowManager);
-INITIALIZE_EQGAME_OFFSET(pinstCContainerMgr);
-INITIALIZE_EQGAME_OFFSET(pinstCContextMenuManager);
-INITIALIZE_EQGAME_OFFSET(pinstCDBStr);
-INITIALIZE_EQGAME_OFFSET(pinstCDisplay);
-INITIALIZE_EQGAME_OFFSET(pinstCEverQuest);
-INITIALIZE_EQGAME_OFFSET(pinstCInvSlotMgr);
-INITIALIZE_EQGAME_OFFSET(pinstCItemDisplayManager);
-INITIALIZE_EQGAME_OFFSET(pinstControlledPlayer);
-INITIALIZE_EQGAME_OFFSET(pinstCMercenaryClientManager);
-INITIALIZE_EQGAME_OFFSET(pinstCPopupWndManager);
-INITIALIZE_EQGAME_OFFSET(pinstCResolutionHandler);
-INITIALIZE_EQGAME_OFFSET(pinstCSidlManager);
-INITIALIZE_EQGAME_OFFSET(pinstCSpellDisplayMgr);
-INITIALIZE_EQGAME_OFFSET(pinstCTaskManager);
-INITIALIZE_EQGAME_OFFSET(pinstCXWndManager);
-INITIALIZE_EQGAME_OFFSET(pinstDZMember);
-INITIALIZE_EQGAME_OFFSET(pinstDZTimerInfo);
-INITIALIZE_EQGAME_OFFSET(pinstEqLogin);
-INITIALIZE_EQGAME_OFFSET(pinstEQSoundManager);
-INITIALIZE_EQGAME_OFFSET(pinstEQSpellStrings);
-INITIALIZE_EQGAME_OFFSET(pinstEQSuiteTextureLoader);
-INITIALIZE_EQGAME_OFFSET(pinstGFViewListener);
-INITIALIZE_EQGAME_OFFSET(pinstEverQuestInfo);
-INITIALIZE_EQGAME_OFFSET(pinstItemIconCache);
-INITIALIZE_EQGAME_OFFSET(pinstLocalPC);
-INITIALIZE_EQGAME_OFFSET(pinstLocalPlayer);
-INITIALIZE_EQGAME_OFFSET(pinstModelPlayer);
-INITIALIZE_EQGAME_OFFSET(pinstRenderInterface);
-INITIALIZE_EQGAME_OFFSET(pinstPlayerPath);
-INITIALIZE_EQGAME_OFFSET(pinstSGraphicsEngine);
-INITIALIZE_EQGAME_OFFSET(pinstDeviceInputProxy);
-INITIALIZE_EQGAME_OFFSET(pinstSkillMgr);
-INITIALIZE_EQGAME_OFFSET(pinstSpawnManager);
-INITIALIZE_EQGAME_OFFSET(pinstSpellManager);
-INITIALIZE_EQGAME_OFFSET(pinstStringTable);
-INITIALIZE_EQGAME_OFFSET(pinstSwitchManager);
-INITIALIZE_EQGAME_OFFSET(pinstTarget);
-INITIALIZE_EQGAME_OFFSET(pinstTargetIndicator);
-INITIALIZE_EQGAME_OFFSET(pinstTaskMember);
-INITIALIZE_EQGAME_OFFSET(pinstTrackTarget);
-INITIALIZE_EQGAME_OFFSET(pinstTradeTarget);
-INITIALIZE_EQGAME_OFFSET(pinstViewActor);
-INITIALIZE_EQGAME_OFFSET(pinstWorldData);
-
-INITIALIZE_EQGAME_OFFSET(__MemChecker0);
-INITIALIZE_EQGAME_OFFSET(__MemChecker1);
-INITIALIZE_EQGAME_OFFSET(__MemChecker4);
-INITIALIZE_EQGAME_OFFSET(__EncryptPad0);
-INITIALIZE_EQGAME_OFFSET(DI8__Keyboard);
-INITIALIZE_EQGAME_OFFSET(DI8__Mouse);
-INITIALIZE_EQGAME_OFFSET(DI8__MouseState);
-
-INITIALIZE_EQGAME_OFFSET(__allowslashcommand);
-INITIALIZE_EQGAME_OFFSET(__CastRay);
-INITIALIZE_EQGAME_OFFSET(__CastRay2);
-INITIALIZE_EQGAME_OFFSET(__CleanItemTags);
-INITIALIZE_EQGAME_OFFSET(__compress_block);
-INITIALIZE_EQGAME_OFFSET(__ConvertItemTags);
-INITIALIZE_EQGAME_OFFSET(__CopyLayout);
-INITIALIZE_EQGAME_OFFSET(__CreateCascadeMenuItems);
-INITIALIZE_EQGAME_OFFSET(__decompress_block);
-INITIALIZE_EQGAME_OFFSET(__DoesFileExist);
-INITIALIZE_EQGAME_OFFSET(__eq_delete);
-INITIALIZE_EQGAME_OFFSET(__eq_new);
-INITIALIZE_EQGAME_OFFSET(__EQGetTime);
-INITIALIZE_EQGAME_OFFSET(__ExecuteCmd);
-INITIALIZE_EQGAME_OFFSET(__FixHeading);
-INITIALIZE_EQGAME_OFFSET(__FlushDxKeyboard);
-INITIALIZE_EQGAME_OFFSET(__get_bearing);
-INITIALIZE_EQGAME_OFFSET(__get_melee_range);
-INITIALIZE_EQGAME_OFFSET(__GetAnimationCache);
-INITIALIZE_EQGAME_OFFSET(__GetGaugeValueFromEQ);
-INITIALIZE_EQGAME_OFFSET(__GetLabelFromEQ);
-INITIALIZE_EQGAME_OFFSET(__GetXTargetType);
-INITIALIZE_EQGAME_OFFSET(__HeadingDiff);
-INITIALIZE_EQGAME_OFFSET(__HelpPath);
-INITIALIZE_EQGAME_OFFSET(__msgTokenTextParam);
-INITIALIZE_EQGAME_OFFSET(__NewUIINI);
-INITIALIZE_EQGAME_OFFSET(__ProcessGameEvents);
-INITIALIZE_EQGAME_OFFSET(__ProcessKeyboardEvents);
-INITIALIZE_EQGAME_OFFSET(__ProcessMouseEvents);
-INITIALIZE_EQGAME_OFFSET(__ProcessDeviceEvents);
-INITIALIZE_EQGAME_OFFSET(__SaveColors);
-INITIALIZE_EQGAME_OFFSET(__STMLToText);
-INITIALIZE_EQGAME_OFFSET(__WndProc);
-
-INITIALIZE_EQGAME_OFFSET(AchievementManager__Instance);
-INITIALIZE_EQGAME_OFFSET(AggroMeterManagerClient__Instance);
-INITIALIZE_EQGAME_OFFSET(AltAdvManager__CanSeeAbility);
-INITIALIZE_EQGAME_OFFSET(AltAdvManager__CanTrainAbility);
-INITIALIZE_EQGAME_OFFSET(AltAdvManager__GetAAById);
-INITIALIZE_EQGAME_OFFSET(AltAdvManager__GetCalculatedTimer);
-INITIALIZE_EQGAME_OFFSET(AltAdvManager__IsAbilityReady);
-INITIALIZE_EQGAME_OFFSET(CAAWnd__ShowAbility);
-INITIALIZE_EQGAME_OFFSET(CAAWnd__Update);
-INITIALIZE_EQGAME_OFFSET(CAAWnd__UpdateSelected);
-INITIALIZE_EQGAME_OFFSET(CAdvancedLootWnd__AddPlayerToList);
-INITIALIZE_EQGAME_OFFSET(CAdvancedLootWnd__DoAdvLootAction);
-INITIALIZE_EQGAME_OFFSET(CAdvancedLootWnd__DoSharedAdvLootAction);
-INITIALIZE_EQGAME_OFFSET(CAdvancedLootWnd__UpdateMasterLooter);
-INITIALIZE_EQGAME_OFFSET(CAltAbilityData__GetMercCurrentRank);
-INITIALIZE_EQGAME_OFFSET(CAltAbilityData__GetMercMaxRank);
-INITIALIZE_EQGAME_OFFSET(CBankWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CBarterSearchWnd__UpdateInventoryList);
-INITIALIZE_EQGAME_OFFSET(CBarterSearchWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CBarterWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CBazaarSearchWnd__HandleSearchResults);
-INITIALIZE_EQGAME_OFFSET(CBroadcast__Get);
-INITIALIZE_EQGAME_OFFSET(CButtonWnd__vftable);
-INITIALIZE_EQGAME_OFFSET(CCastSpellWnd__ForgetMemorizedSpell);
-INITIALIZE_EQGAME_OFFSET(CCastSpellWnd__IsBardSongPlaying);
-INITIALIZE_EQGAME_OFFSET(CCastSpellWnd__RefreshSpellGemButtons);
-INITIALIZE_EQGAME_OFFSET(CCharacterListWnd__EnterWorld);
-INITIALIZE_EQGAME_OFFSET(CCharacterListWnd__Quit);
-INITIALIZE_EQGAME_OFFSET(CCharacterListWnd__SelectCharacter);
-INITIALIZE_EQGAME_OFFSET(CCharacterListWnd__UpdateList);
-INITIALIZE_EQGAME_OFFSET(CChatService__GetFriendName);
-INITIALIZE_EQGAME_OFFSET(CChatService__GetNumberOfFriends);
-INITIALIZE_EQGAME_OFFSET(CChatWindow__AddHistory);
-INITIALIZE_EQGAME_OFFSET(CChatWindow__CChatWindow);
-INITIALIZE_EQGAME_OFFSET(CChatWindow__Clear);
-INITIALIZE_EQGAME_OFFSET(CChatWindow__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CChatWindowManager__CreateChatWindow);
-INITIALIZE_EQGAME_OFFSET(CChatWindowManager__FreeChatWindow);
-INITIALIZE_EQGAME_OFFSET(CChatWindowManager__GetRGBAFromIndex);
-INITIALIZE_EQGAME_OFFSET(CChatWindowManager__InitContextMenu);
-INITIALIZE_EQGAME_OFFSET(CChatWindowManager__SetLockedActiveChatWindow);
-INITIALIZE_EQGAME_OFFSET(CColorPickerWnd__Open);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__DeleteAll);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__Draw);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__GetChoiceText);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__GetCurChoice);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__GetCurChoiceText);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__GetItemCount);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__GetListRect);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__InsertChoice);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__InsertChoiceAtIndex);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__SetChoice);
-INITIALIZE_EQGAME_OFFSET(CComboWnd__SetColors);
-INITIALIZE_EQGAME_OFFSET(CContainerMgr__CloseContainer);
-INITIALIZE_EQGAME_OFFSET(CContainerMgr__OpenContainer);
-INITIALIZE_EQGAME_OFFSET(CContainerMgr__OpenExperimentContainer);
-INITIALIZE_EQGAME_OFFSET(CContainerWnd__HandleCombine);
-INITIALIZE_EQGAME_OFFSET(CContainerWnd__SetContainer);
-INITIALIZE_EQGAME_OFFSET(CContainerWnd__vftable);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__AddMenuItem);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__AddSeparator);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__CheckMenuItem);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__RemoveAllMenuItems);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__RemoveMenuItem);
-INITIALIZE_EQGAME_OFFSET(CContextMenu__SetMenuItem);
-INITIALIZE_EQGAME_OFFSET(CContextMenuManager__AddMenu);
-INITIALIZE_EQGAME_OFFSET(CContextMenuManager__CreateDefaultMenu);
-INITIALIZE_EQGAME_OFFSET(CContextMenuManager__Flush);
-INITIALIZE_EQGAME_OFFSET(CContextMenuManager__PopupMenu);
-INITIALIZE_EQGAME_OFFSET(CContextMenuManager__RemoveMenu);
-INITIALIZE_EQGAME_OFFSET(CCursorAttachment__AttachToCursor);
-INITIALIZE_EQGAME_OFFSET(CCursorAttachment__IsOkToActivate);
-INITIALIZE_EQGAME_OFFSET(CCursorAttachment__RemoveAttachment);
-INITIALIZE_EQGAME_OFFSET(CDBStr__GetString);
-INITIALIZE_EQGAME_OFFSET(CDisplay__cameraType);
-INITIALIZE_EQGAME_OFFSET(CDisplay__CleanGameUI);
-INITIALIZE_EQGAME_OFFSET(CDisplay__GetClickedActor);
-INITIALIZE_EQGAME_OFFSET(CDisplay__GetFloorHeight);
-INITIALIZE_EQGAME_OFFSET(CDisplay__GetUserDefinedColor);
-INITIALIZE_EQGAME_OFFSET(CDisplay__InitCharSelectUI);
-INITIALIZE_EQGAME_OFFSET(CDisplay__PreZoneMainUI);
-INITIALIZE_EQGAME_OFFSET(CDisplay__RealRender_World);
-INITIALIZE_EQGAME_OFFSET(CDisplay__ReloadUI);
-INITIALIZE_EQGAME_OFFSET(CDisplay__RestartUI);
-INITIALIZE_EQGAME_OFFSET(CDisplay__SetViewActor);
-INITIALIZE_EQGAME_OFFSET(CDisplay__ToggleScreenshotMode);
-INITIALIZE_EQGAME_OFFSET(CDisplay__TrueDistance);
-INITIALIZE_EQGAME_OFFSET(CDisplay__WriteTextHD2);
-INITIALIZE_EQGAME_OFFSET(CDisplay__ZoneMainUI);
-INITIALIZE_EQGAME_OFFSET(CDistillerInfo__GetIDFromRecordNum);
-INITIALIZE_EQGAME_OFFSET(CDistillerInfo__Instance);
-INITIALIZE_EQGAME_OFFSET(CEditBaseWnd__SetSel);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__DrawCaret);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__EnsureCaretVisible);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetCaretPt);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetCharIndexPt);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetDisplayString);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetHorzOffset);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetLineForPrintableChar);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetSelStartPt);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__GetSTMLSafeText);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__PointFromPrintableChar);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__ReplaceSelection);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__SelectableCharFromPoint);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__SetEditable);
-INITIALIZE_EQGAME_OFFSET(CEditWnd__SetWindowText);
-INITIALIZE_EQGAME_OFFSET(CEQSuiteTextureLoader__CreateTexture);
-INITIALIZE_EQGAME_OFFSET(CEQSuiteTextureLoader__GetDefaultUIPath);
-INITIALIZE_EQGAME_OFFSET(CEQSuiteTextureLoader__GetTexture);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__ClickedPlayer);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__CreateTargetIndicator);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__DoPercentConvert);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__DoTellWindow);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__DropHeldItemOnGround);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__dsp_chat);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__Emote);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetBodyTypeDesc);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetClassDesc);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetClassThreeLetterCode);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetDeityDesc);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetLangDesc);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__GetRaceDesc);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__InterpretCmd);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__IssuePetCommand);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__LeftClickedOnPlayer);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__LMouseUp);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__OutputTextToLog);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__ReportSuccessfulHeal);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__ReportSuccessfulHit);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__RightClickedOnPlayer);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__RMouseUp);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__SetGameState);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__trimName);
-INITIALIZE_EQGAME_OFFSET(CEverQuest__UPCNotificationFlush);
-INITIALIZE_EQGAME_OFFSET(CFindItemWnd__PickupSelectedItem);
-INITIALIZE_EQGAME_OFFSET(CFindItemWnd__Update);
-INITIALIZE_EQGAME_OFFSET(CFindItemWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CGaugeWnd__Draw);
-INITIALIZE_EQGAME_OFFSET(CGroupWnd__UpdateDisplay);
-INITIALIZE_EQGAME_OFFSET(CGroupWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CGuild__FindMemberByName);
-INITIALIZE_EQGAME_OFFSET(CGuild__GetGuildName);
-INITIALIZE_EQGAME_OFFSET(CharacterBase__GetItemByGlobalIndex);
-INITIALIZE_EQGAME_OFFSET(CharacterBase__GetItemByGlobalIndex1);
-INITIALIZE_EQGAME_OFFSET(CharacterBase__IsExpansionFlag);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__BardCastBard);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CalcAffectChange);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CalcAffectChangeGeneric);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CanMedOnHorse);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CanUseItem);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CanUseMemorizedSpellSlot);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CastSpell);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__CharacterZoneClient);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__Cur_HP);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__Cur_Mana);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__FindAffectSlot);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetAdjustedSkill);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetBaseSkill);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetCastingTimeModifier);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetCurrentMod);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetCursorItemCount);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetEnduranceRegen);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetFirstEffectSlot);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetFocusCastingTimeModifier);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetFocusDurationMod);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetHPRegen);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetItemCountInInventory);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetItemCountWorn);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetLastEffectSlot);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetManaRegen);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetModCap);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetOpenEffectSlot);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetPctModAndMin);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__GetPCSpellAffect);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__HasSkill);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__HitBySpell);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__IsStackBlocked);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__MakeMeVisible);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__Max_Endurance);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__Max_HP);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__Max_Mana);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__NotifyPCAffectChange);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__RemovePCAffectex);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__SpellDuration);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__TotalEffect);
-INITIALIZE_EQGAME_OFFSET(CharacterZoneClient__UseSkill);
-INITIALIZE_EQGAME_OFFSET(ChatManagerClient__Instance);
-INITIALIZE_EQGAME_OFFSET(CHelpWnd__SetFile);
-INITIALIZE_EQGAME_OFFSET(CHotButton__SetButtonSize);
-INITIALIZE_EQGAME_OFFSET(CHotButton__SetCheck);
-INITIALIZE_EQGAME_OFFSET(CHotButtonWnd__DoHotButton);
-INITIALIZE_EQGAME_OFFSET(CInvSlot__GetItemBase);
-INITIALIZE_EQGAME_OFFSET(CInvSlot__HandleRButtonUp);
-INITIALIZE_EQGAME_OFFSET(CInvSlot__SliderComplete);
-INITIALIZE_EQGAME_OFFSET(CInvSlot__UpdateItem);
-INITIALIZE_EQGAME_OFFSET(CInvSlotMgr__FindInvSlot);
-INITIALIZE_EQGAME_OFFSET(CInvSlotMgr__MoveItem);
-INITIALIZE_EQGAME_OFFSET(CInvSlotMgr__SelectSlot);
-INITIALIZE_EQGAME_OFFSET(CInvSlotWnd__CInvSlotWnd);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayManager__CreateWindowInstance);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayWnd__InsertAugmentRequest);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayWnd__RemoveAugmentRequest);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayWnd__RequestConvertItem);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayWnd__SetItem);
-INITIALIZE_EQGAME_OFFSET(CItemDisplayWnd__UpdateStrings);
-INITIALIZE_EQGAME_OFFSET(CKeyRingWnd__ExecuteRightClick);
-INITIALIZE_EQGAME_OFFSET(CLabel__UpdateText);
-INITIALIZE_EQGAME_OFFSET(CLargeDialogWnd__Open);
-INITIALIZE_EQGAME_OFFSET(ClientSOIManager__GetSingleton);
-INITIALIZE_EQGAME_OFFSET(CListWnd__AddColumn);
-INITIALIZE_EQGAME_OFFSET(CListWnd__AddColumn1);
-INITIALIZE_EQGAME_OFFSET(CListWnd__AddLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__AddString);
-INITIALIZE_EQGAME_OFFSET(CListWnd__CalculateCustomWindowPositions);
-INITIALIZE_EQGAME_OFFSET(CListWnd__CalculateFirstVisibleLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__CalculateVSBRange);
-INITIALIZE_EQGAME_OFFSET(CListWnd__ClearAllSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__ClearSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__CListWnd);
-INITIALIZE_EQGAME_OFFSET(CListWnd__CloseAndUpdateEditWindow);
-INITIALIZE_EQGAME_OFFSET(CListWnd__Compare);
-INITIALIZE_EQGAME_OFFSET(CListWnd__dCListWnd);
-INITIALIZE_EQGAME_OFFSET(CListWnd__Draw);
-INITIALIZE_EQGAME_OFFSET(CListWnd__DrawColumnSeparators);
-INITIALIZE_EQGAME_OFFSET(CListWnd__DrawHeader);
-INITIALIZE_EQGAME_OFFSET(CListWnd__DrawItem);
-INITIALIZE_EQGAME_OFFSET(CListWnd__DrawLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__DrawSeparator);
-INITIALIZE_EQGAME_OFFSET(CListWnd__EnableLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__EnsureVisible);
-INITIALIZE_EQGAME_OFFSET(CListWnd__ExtendSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetColumnMinWidth);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetColumnWidth);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetCurSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetItemData);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetItemHeight);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetItemRect);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetItemText);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetItemWnd);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetSelList);
-INITIALIZE_EQGAME_OFFSET(CListWnd__GetSeparatorRect);
-INITIALIZE_EQGAME_OFFSET(CListWnd__InsertLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__RemoveLine);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetColors);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetColumnJustification);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetColumnLabel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetColumnsSizable);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetColumnWidth);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetCurSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetItemColor);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetItemData);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetItemIcon);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetItemText);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetItemWnd);
-INITIALIZE_EQGAME_OFFSET(CListWnd__SetVScrollPos);
-INITIALIZE_EQGAME_OFFSET(CListWnd__Sort);
-INITIALIZE_EQGAME_OFFSET(CListWnd__ToggleSel);
-INITIALIZE_EQGAME_OFFSET(CListWnd__vftable);
-INITIALIZE_EQGAME_OFFSET(CLootWnd__LootAll);
-INITIALIZE_EQGAME_OFFSET(CLootWnd__RequestLootSlot);
-INITIALIZE_EQGAME_OFFSET(CMapViewWnd__CMapViewWnd);
-INITIALIZE_EQGAME_OFFSET(CMemoryMappedFile__SetFile);
-INITIALIZE_EQGAME_OFFSET(CMerchantWnd__DisplayBuyOrSellPrice);
-INITIALIZE_EQGAME_OFFSET(CMerchantWnd__PurchasePageHandler__RequestGetItem);
-INITIALIZE_EQGAME_OFFSET(CMerchantWnd__PurchasePageHandler__RequestPutItem);
-INITIALIZE_EQGAME_OFFSET(CMerchantWnd__PurchasePageHandler__UpdateList);
-INITIALIZE_EQGAME_OFFSET(CMerchantWnd__SelectBuySellSlot);
-INITIALIZE_EQGAME_OFFSET(COptionsWnd__FillChatFilterList);
-INITIALIZE_EQGAME_OFFSET(CPacketScrambler__hton);
-INITIALIZE_EQGAME_OFFSET(CPacketScrambler__ntoh);
-INITIALIZE_EQGAME_OFFSET(CPageWnd__FlashTab);
-INITIALIZE_EQGAME_OFFSET(CPageWnd__SetTabText);
-INITIALIZE_EQGAME_OFFSET(CQuantityWnd__Open);
-INITIALIZE_EQGAME_OFFSET(CResolutionHandler__GetWindowedStyle);
-INITIALIZE_EQGAME_OFFSET(CResolutionHandler__UpdateResolution);
-INITIALIZE_EQGAME_OFFSET(CScreenPieceTemplate__IsType);
-INITIALIZE_EQGAME_OFFSET(CSidlManager__CreateHotButtonWnd);
-INITIALIZE_EQGAME_OFFSET(CSidlManager__CreateXWnd);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__CreateXWnd);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__CreateXWndFromTemplate);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__CreateXWndFromTemplate1);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__FindAnimation1);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__FindButtonDrawTemplate);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__FindScreenPieceTemplate);
-INITIALIZE_EQGAME_OFFSET(CSidlManagerBase__FindScreenPieceTemplate1);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__CalculateHSBRange);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__CalculateVSBRange);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__ConvertToRes);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__CreateChildrenFromSidl);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__CSidlScreenWnd1);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__CSidlScreenWnd2);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__dCSidlScreenWnd);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__DrawSidlPiece);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__EnableIniStorage);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__GetChildItem);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__GetSidlPiece);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__Init1);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__LoadIniListWnd);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__LoadSidlScreen);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__m_layoutCopy);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__StoreIniVis);
-INITIALIZE_EQGAME_OFFSET(CSidlScreenWnd__vftable);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__GetNameToken);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__GetSkillCap);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__IsActivatedSkill);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__IsAvailable);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__IsCombatSkill);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__GetSkillTimerDuration);
-INITIALIZE_EQGAME_OFFSET(CSkillMgr__GetSkillLastUsed);
-INITIALIZE_EQGAME_OFFSET(CSliderWnd__GetValue);
-INITIALIZE_EQGAME_OFFSET(CSliderWnd__SetNumTicks);
-INITIALIZE_EQGAME_OFFSET(CSliderWnd__SetValue);
-INITIALIZE_EQGAME_OFFSET(CSpellBookWnd__MemorizeSet);
-INITIALIZE_EQGAME_OFFSET(CSpellDisplayWnd__SetSpell);
-INITIALIZE_EQGAME_OFFSET(CSpellDisplayWnd__UpdateStrings);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__AppendSTML);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__CalculateHSBRange);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__CalculateVSBRange);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__FastForwardToEndOfTag);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__ForceParseNow);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__GetVisibleText);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__MakeStmlColorTag);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__MakeWndNotificationTag);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__SetSTMLText);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__StripFirstSTMLLines);
-INITIALIZE_EQGAME_OFFSET(CStmlWnd__UpdateHistoryString);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__Draw);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__DrawCurrentPage);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__DrawTab);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__GetTabRect);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__InsertPage);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__RemovePage);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__SetPage);
-INITIALIZE_EQGAME_OFFSET(CTabWnd__UpdatePage);
-INITIALIZE_EQGAME_OFFSET(CTargetManager__Get);
-INITIALIZE_EQGAME_OFFSET(CTargetWnd__HandleBuffRemoveRequest);
-INITIALIZE_EQGAME_OFFSET(CTargetWnd__RefreshTargetBuffs);
-INITIALIZE_EQGAME_OFFSET(CTargetWnd__WndNotification);
-INITIALIZE_EQGAME_OFFSET(CTaskManager__GetElementDescription);
-INITIALIZE_EQGAME_OFFSET(CTaskManager__GetEntry);
-INITIALIZE_EQGAME_OFFSET(CTaskManager__GetTaskStatus);
-INITIALIZE_EQGAME_OFFSET(CTaskWnd__UpdateTaskTimers);
-INITIALIZE_EQGAME_OFFSET(CTextOverlay__DisplayText);
-INITIALIZE_EQGAME_OFFSET(CTextureAnimation__Draw);
-INITIALIZE_EQGAME_OFFSET(CTextureAnimation__SetCurCell);
-INITIALIZE_EQGAME_OFFSET(CTextureFont__DrawWrappedText);
-INITIALIZE_EQGAME_OFFSET(CTextureFont__DrawWrappedText1);
-INITIALIZE_EQGAME_OFFSET(CTextureFont__DrawWrappedText2);
-INITIALIZE_EQGAME_OFFSET(CTextureFont__GetHeight);
-INITIALIZE_EQGAME_OFFSET(CTextureFont__GetTextExtent);
-INITIALIZE_EQGAME_OFFSET(CTribute__GetActiveFavorCost);
-INITIALIZE_EQGAME_OFFSET(CUnSerializeBuffer__GetString);
-INITIALIZE_EQGAME_OFFSET(CWndDisplayManager__FindWindow);
-INITIALIZE_EQGAME_OFFSET(CXMLDataManager__GetXMLData);
-INITIALIZE_EQGAME_OFFSET(CXMLSOMDocumentBase__XMLRead);
-INITIALIZE_EQGAME_OFFSET(CXStr__gCXStrAccess);
-INITIALIZE_EQGAME_OFFSET(CXStr__gFreeLists);
-INITIALIZE_EQGAME_OFFSET(CXWnd__BringToTop);
-INITIALIZE_EQGAME_OFFSET(CXWnd__ClrFocus);
-INITIALIZE_EQGAME_OFFSET(CXWnd__CXWnd);
-INITIALIZE_EQGAME_OFFSET(CXWnd__dCXWnd);
-INITIALIZE_EQGAME_OFFSET(CXWnd__Destroy);
-INITIALIZE_EQGAME_OFFSET(CXWnd__DoAllDrawing);
-INITIALIZE_EQGAME_OFFSET(CXWnd__DrawColoredRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__DrawTooltip);
-INITIALIZE_EQGAME_OFFSET(CXWnd__DrawTooltipAtPoint);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetChildItem);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetChildWndAt);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetClientClipRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetClientRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetRelativeRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetScreenClipRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetScreenRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__GetTooltipRect);
-INITIALIZE_EQGAME_OFFSET(CXWnd__IsActive);
-INITIALIZE_EQGAME_OFFSET(CXWnd__IsDescendantOf);
-INITIALIZE_EQGAME_OFFSET(CXWnd__IsReallyVisible);
-INITIALIZE_EQGAME_OFFSET(CXWnd__IsType);
-INITIALIZE_EQGAME_OFFSET(CXWnd__Minimize);
-INITIALIZE_EQGAME_OFFSET(CXWnd__ProcessTransition);
-INITIALIZE_EQGAME_OFFSET(CXWnd__Resize);
-INITIALIZE_EQGAME_OFFSET(CXWnd__Right);
-INITIALIZE_EQGAME_OFFSET(CXWnd__SetFocus);
-INITIALIZE_EQGAME_OFFSET(CXWnd__SetFont);
-INITIALIZE_EQGAME_OFFSET(CXWnd__SetKeyTooltip);
-INITIALIZE_EQGAME_OFFSET(CXWnd__SetMouseOver);
-INITIALIZE_EQGAME_OFFSET(CXWnd__SetParent);
-INITIALIZE_EQGAME_OFFSET(CXWnd__StartFade);
-INITIALIZE_EQGAME_OFFSET(CXWnd__vftable);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__DestroyAllWindows);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__DrawCursor);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__DrawWindows);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__GetKeyboardFlags);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__HandleKeyboardMsg);
-INITIALIZE_EQGAME_OFFSET(CXWndManager__RemoveWnd);
-INITIALIZE_EQGAME_OFFSET(DrawNetStatus);
-INITIALIZE_EQGAME_OFFSET(EQ_LoadingS__Array);
-INITIALIZE_EQGAME_OFFSET(EQ_LoadingS__SetProgressBar);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__GetSpellAffectByIndex);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__GetSpellAffectBySlot);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__GetSpellLevelNeeded);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__IsDegeneratingLevelMod);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__IsSPAIgnoredByStacking);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__IsSPAStacking);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__SpellAffectBase);
-INITIALIZE_EQGAME_OFFSET(EQ_Spell__SpellAffects);
-INITIALIZE_EQGAME_OFFSET(EQGroundItemListManager__Instance);
-INITIALIZE_EQGAME_OFFSET(EQItemList__add_item);
-INITIALIZE_EQGAME_OFFSET(EQItemList__delete_item);
-INITIALIZE_EQGAME_OFFSET(EQItemList__EQItemList);
-INITIALIZE_EQGAME_OFFSET(EQItemList__FreeItemList);
-INITIALIZE_EQGAME_OFFSET(EQPlacedItemManager__GetItemByGuid);
-INITIALIZE_EQGAME_OFFSET(EQPlacedItemManager__GetItemByRealEstateAndRealEstateItemIds);
-INITIALIZE_EQGAME_OFFSET(EQPlacedItemManager__Instance);
-INITIALIZE_EQGAME_OFFSET(EqSoundManager__PlayScriptMp3);
-INITIALIZE_EQGAME_OFFSET(EqSoundManager__SoundAssistPlay);
-INITIALIZE_EQGAME_OFFSET(EqSoundManager__WaveInstancePlay);
-INITIALIZE_EQGAME_OFFSET(EqSoundManager__WavePlay);
-INITIALIZE_EQGAME_OFFSET(EQSpellStrings__GetString);
-INITIALIZE_EQGAME_OFFSET(EQSwitch__UseSwitch);
-INITIALIZE_EQGAME_OFFSET(FactionManagerClient__HandleFactionMessage);
-INITIALIZE_EQGAME_OFFSET(FactionManagerClient__Instance);
-INITIALIZE_EQGAME_OFFSET(FreeTargetTracker__CastSpell);
-INITIALIZE_EQGAME_OFFSET(FreeToPlayClient__Instance);
-INITIALIZE_EQGAME_OFFSET(FreeToPlayClient__RestrictionInfo);
-INITIALIZE_EQGAME_OFFSET(IconCache__GetIcon);
-INITIALIZE_EQGAME_OFFSET(ItemBase__CanGemFitInSlot);
-INITIALIZE_EQGAME_OFFSET(ItemBase__CreateItemTagString);
-INITIALIZE_EQGAME_OFFSET(ItemBase__GetImageNum);
-INITIALIZE_EQGAME_OFFSET(ItemBase__GetItemValue);
-INITIALIZE_EQGAME_OFFSET(ItemBase__IsEmpty);
-INITIALIZE_EQGAME_OFFSET(ItemBase__IsKeyRingItem);
-INITIALIZE_EQGAME_OFFSET(ItemBase__IsLore);
-INITIALIZE_EQGAME_OFFSET(ItemBase__IsLoreEquipped);
-INITIALIZE_EQGAME_OFFSET(ItemBase__ValueSellMerchant);
-INITIALIZE_EQGAME_OFFSET(ItemClient__CanDrop);
-INITIALIZE_EQGAME_OFFSET(ItemClient__CanGoInBag);
-INITIALIZE_EQGAME_OFFSET(ItemClient__CreateItemClient);
-INITIALIZE_EQGAME_OFFSET(ItemClient__dItemClient);
-INITIALIZE_EQGAME_OFFSET(KeyCombo__GetTextDescription);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__AttachAltKeyToEqCommand);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__AttachKeyToEqCommand);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__ClearCommandStateArray);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__Get);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__HandleKeyDown);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__HandleKeyUp);
-INITIALIZE_EQGAME_OFFSET(KeypressHandler__SaveKeymapping);
-INITIALIZE_EQGAME_OFFSET(LootFiltersManager__AddItemLootFilter);
-INITIALIZE_EQGAME_OFFSET(LootFiltersManager__GetItemFilterData);
-INITIALIZE_EQGAME_OFFSET(LootFiltersManager__RemoveItemLootFilter);
-INITIALIZE_EQGAME_OFFSET(LootFiltersManager__SetItemLootFilter);
-INITIALIZE_EQGAME_OFFSET(MapViewMap__Clear);
-INITIALIZE_EQGAME_OFFSET(MapViewMap__SetZoom);
-INITIALIZE_EQGAME_OFFSET(MapViewMap__vftable);
-INITIALIZE_EQGAME_OFFSET(MercenaryAlternateAdvancementManagerClient__BuyAbility);
-INITIALIZE_EQGAME_OFFSET(MercenaryAlternateAdvancementManagerClient__Instance);
-INITIALIZE_EQGAME_OFFSET(msg_new_text);
-INITIALIZE_EQGAME_OFFSET(msg_spell_worn_off);
-INITIALIZE_EQGAME_OFFSET(msgTokenText);
-INITIALIZE_EQGAME_OFFSET(MultipleItemMoveManager__ProcessMove);
-INITIALIZE_EQGAME_OFFSET(PcBase__GetAlternateAbilityId);
-INITIALIZE_EQGAME_OFFSET(PcBase__GetCombatAbility);
-INITIALIZE_EQGAME_OFFSET(PcBase__GetCombatAbilityTimer);
-INITIALIZE_EQGAME_OFFSET(PcBase__GetItemContainedRealEstateIds);
-INITIALIZE_EQGAME_OFFSET(PcBase__GetNonArchivedOwnedRealEstates);
-INITIALIZE_EQGAME_OFFSET(PcClient__AlertInventoryChanged);
-INITIALIZE_EQGAME_OFFSET(PcClient__GetConLevel);
-INITIALIZE_EQGAME_OFFSET(PcClient__GetMeleeSpellFromSkillIndex);
-INITIALIZE_EQGAME_OFFSET(PcClient__HasLoreItem);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__BandolierSwap);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__CanEquipItem);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__DestroyHeldItemOrMoney);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__doCombatAbility);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__GetItemByID);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__GetItemRecastTimer);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__GetPcSkillLimit);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__HasAlternateAbility);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__RemoveBuffEffect);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__RemoveMyAffect);
-INITIALIZE_EQGAME_OFFSET(PcZoneClient__RemovePetEffect);
-INITIALIZE_EQGAME_OFFSET(pinstLootFiltersManager);
-INITIALIZE_EQGAME_OFFSET(PlayerBase__CanSee);
-INITIALIZE_EQGAME_OFFSET(PlayerBase__CanSee1);
-INITIALIZE_EQGAME_OFFSET(PlayerBase__GetVisibilityLineSegment);
-INITIALIZE_EQGAME_OFFSET(PlayerBase__HasProperty);
-INITIALIZE_EQGAME_OFFSET(PlayerBase__IsTargetable);
-INITIALIZE_EQGAME_OFFSET(PlayerClient__ChangeBoneStringSprite);
-INITIALIZE_EQGAME_OFFSET(PlayerClient__GetPcClient);
-INITIALIZE_EQGAME_OFFSET(PlayerClient__SetNameSpriteState);
-INITIALIZE_EQGAME_OFFSET(PlayerClient__SetNameSpriteTint);
-INITIALIZE_EQGAME_OFFSET(PlayerManagerBase__PrepForDestroyPlayer);
-INITIALIZE_EQGAME_OFFSET(PlayerManagerClient__CreatePlayer);
-INITIALIZE_EQGAME_OFFSET(PlayerManagerClient__GetPlayerFromPartialName);
-INITIALIZE_EQGAME_OFFSET(PlayerManagerClient__GetSpawnByID);
-INITIALIZE_EQGAME_OFFSET(PlayerManagerClient__GetSpawnByName);
-INITIALIZE_EQGAME_OFFSET(PlayerPointManager__GetAltCurrency);
-INITIALIZE_EQGAME_OFFSET(PlayerZoneClient__ChangeHeight);
-INITIALIZE_EQGAME_OFFSET(PlayerZoneClient__DoAttack);
-INITIALIZE_EQGAME_OFFSET(PlayerZoneClient__GetLevel);
-INITIALIZE_EQGAME_OFFSET(PlayerZoneClient__IsValidTeleport);
-INITIALIZE_EQGAME_OFFSET(PlayerZoneClient__LegalPlayerRace);
-INITIALIZE_EQGAME_OFFSET(ProfileManager__GetCurrentProfile);
-INITIALIZE_EQGAME_OFFSET(RealEstateManagerClient__Instance);
-INITIALIZE_EQGAME_OFFSET(SpellManager__GetSpellByGroupAndRank);
-INITIALIZE_EQGAME_OFFSET(Spellmanager__LoadTextSpells);
-INITIALIZE_EQGAME_OFFSET(StringTable__getString);
-INITIALIZE_EQGAME_OFFSET(Teleport_Table_Size);
-INITIALIZE_EQGAME_OFFSET(Teleport_Table);
-INITIALIZE_EQGAME_OFFSET(UdpConnection__GetStats);
-INITIALIZE_EQGAME_OFFSET(Util__FastTime);
-INITIALIZE_EQGAME_OFFSET(ZoneGuideManagerClient__Instance);
+// Every eqgame.exe offset is listed here once. Each one becomes a statically initialized variable
+// holding its preferred address and an entry in the offset registry, and the whole registry is
+// rebased to the actual load address in a single pass.
+#define EQGAME_OFFSET_LIST(X)                                       \
+	X(__ActualVersionBuild)                                         \
+	X(__ActualVersionDate)                                          \
+	X(__ActualVersionTime)                                          \
+	X(__BindList)                                                   \
+	X(__ChatFilterDefs)                                             \
+	X(__CommandList)                                                \
+	X(__CurrentMapLabel)                                            \
+	X(__CurrentSocial)                                              \
+	X(__do_loot)                                                    \
+	X(__gpbCommandEvent)                                            \
+	X(__Guilds)                                                     \
+	X(__gWorld)                                                     \
+	X(__heqmain)                                                    \
+	X(__HWnd)                                                       \
+	X(__LabelCache)                                                 \
+	X(__LoginName)                                                  \
+	X(__MemCheckBitmask)                                            \
+	X(__MemCheckActive)                                             \
+	X(__Mouse)                                                      \
+	X(__MouseEventTime)                                             \
+	X(__ScreenMode)                                                 \
+	X(__ServerHost)                                                 \
+	X(__ThrottleFrameRate)                                          \
+	X(__ThrottleFrameRateEnd)                                       \
+	X(EQObject_Top)                                                 \
+	X(g_eqCommandStates)                                            \
+	X(instCRaid)                                                    \
+	X(instDynamicZone)                                              \
+	X(instTribute)                                                  \
+	X(instEQZoneInfo)                                               \
+	X(instExpeditionLeader)                                         \
+	X(instExpeditionName)                                           \
+	X(instTributeActive)                                            \
+	X(pinstActiveBanker)                                            \
+	X(pinstActiveCorpse)                                            \
+	X(pinstActiveGMaster)                                           \
+	X(pinstActiveMerchant)                                          \
+	X(pinstAltAdvManager)                                           \
+	X(pinstCamActor)                                                \
+	X(pinstCChatWindowManager)                                      \
+	X(pinstCContainerMgr)                                           \
+	X(pinstCContextMenuManager)                                     \
+	X(pinstCDBStr)                                                  \
+	X(pinstCDisplay)                                                \
+	X(pinstCEverQuest)                                              \
+	X(pinstCInvSlotMgr)                                             \
+	X(pinstCItemDisplayManager)                                     \
+	X(pinstControlledPlayer)                                        \
+	X(pinstCMercenaryClientManager)                                 \
+	X(pinstCPopupWndManager)                                        \
+	X(pinstCResolutionHandler)                                      \
+	X(pinstCSidlManager)                                            \
+	X(pinstCSpellDisplayMgr)                                        \
+	X(pinstCTaskManager)                                            \
+	X(pinstCXWndManager)                                            \
+	X(pinstDZMember)                                                \
+	X(pinstDZTimerInfo)                                             \
+	X(pinstEqLogin)                                                 \
+	X(pinstEQSoundManager)                                          \
+	X(pinstEQSpellStrings)                                          \
+	X(pinstEQSuiteTextureLoader)                                    \
+	X(pinstGFViewListener)                                          \
+	X(pinstEverQuestInfo)                                           \
+	X(pinstItemIconCache)                                           \
+	X(pinstLocalPC)                                                 \
+	X(pinstLocalPlayer)                                             \
+	X(pinstModelPlayer)                                             \
+	X(pinstRenderInterface)                                         \
+	X(pinstPlayerPath)                                              \
+	X(pinstSGraphicsEngine)                                         \
+	X(pinstDeviceInputProxy)                                        \
+	X(pinstSkillMgr)                                                \
+	X(pinstSpawnManager)                                            \
+	X(pinstSpellManager)                                            \
+	X(pinstStringTable)                                             \
+	X(pinstSwitchManager)                                           \
+	X(pinstTarget)                                                  \
+	X(pinstTargetIndicator)                                         \
+	X(pinstTaskMember)                                              \
+	X(pinstTrackTarget)                                             \
+	X(pinstTradeTarget)                                             \
+	X(pinstViewActor)                                               \
+	X(pinstWorldData)                                               \
+	X(__MemChecker0)                                                \
+	X(__MemChecker1)                                                \
+	X(__MemChecker4)                                                \
+	X(__EncryptPad0)                                                \
+	X(DI8__Keyboard)                                                \
+	X(DI8__Mouse)                                                   \
+	X(DI8__MouseState)                                              \
+	X(__allowslashcommand)                                          \
+	X(__CastRay)                                                    \
+	X(__CastRay2)                                                   \
+	X(__CleanItemTags)                                              \
+	X(__compress_block)                                             \
+	X(__ConvertItemTags)                                            \
+	X(__CopyLayout)                                                 \
+	X(__CreateCascadeMenuItems)                                     \
+	X(__decompress_block)                                           \
+	X(__DoesFileExist)                                              \
+	X(__eq_delete)                                                  \
+	X(__eq_new)                                                     \
+	X(__EQGetTime)                                                  \
+	X(__ExecuteCmd)                                                 \
+	X(__FixHeading)                                                 \
+	X(__FlushDxKeyboard)                                            \
+	X(__get_bearing)                                                \
+	X(__get_melee_range)                                            \
+	X(__GetAnimationCache)                                          \
+	X(__GetGaugeValueFromEQ)                                        \
+	X(__GetLabelFromEQ)                                             \
+	X(__GetXTargetType)                                             \
+	X(__HeadingDiff)                                                \
+	X(__HelpPath)                                                   \
+	X(__msgTokenTextParam)                                          \
+	X(__NewUIINI)                                                   \
+	X(__ProcessGameEvents)                                          \
+	X(__ProcessKeyboardEvents)                                      \
+	X(__ProcessMouseEvents)                                         \
+	X(__ProcessDeviceEvents)                                        \
+	X(__SaveColors)                                                 \
+	X(__STMLToText)                                                 \
+	X(__WndProc)                                                    \
+	X(AchievementManager__Instance)                                 \
+	X(AggroMeterManagerClient__Instance)                            \
+	X(AltAdvManager__CanSeeAbility)                                 \
+	X(AltAdvManager__CanTrainAbility)                               \
+	X(AltAdvManager__GetAAById)                                     \
+	X(AltAdvManager__GetCalculatedTimer)                            \
+	X(AltAdvManager__IsAbilityReady)                                \
+	X(CAAWnd__ShowAbility)                                          \
+	X(CAAWnd__Update)                                               \
+	X(CAAWnd__UpdateSelected)                                       \
+	X(CAdvancedLootWnd__AddPlayerToList)                            \
+	X(CAdvancedLootWnd__DoAdvLootAction)                            \
+	X(CAdvancedLootWnd__DoSharedAdvLootAction)                      \
+	X(CAdvancedLootWnd__UpdateMasterLooter)                         \
+	X(CAltAbilityData__GetMercCurrentRank)                          \
+	X(CAltAbilityData__GetMercMaxRank)                              \
+	X(CBankWnd__WndNotification)                                    \
+	X(CBarterSearchWnd__UpdateInventoryList)                        \
+	X(CBarterSearchWnd__WndNotification)                            \
+	X(CBarterWnd__WndNotification)                                  \
+	X(CBazaarSearchWnd__HandleSearchResults)                        \
+	X(CBroadcast__Get)                                              \
+	X(CButtonWnd__vftable)                                          \
+	X(CCastSpellWnd__ForgetMemorizedSpell)                          \
+	X(CCastSpellWnd__IsBardSongPlaying)                             \
+	X(CCastSpellWnd__RefreshSpellGemButtons)                        \
+	X(CCharacterListWnd__EnterWorld)                                \
+	X(CCharacterListWnd__Quit)                                      \
+	X(CCharacterListWnd__SelectCharacter)                           \
+	X(CCharacterListWnd__UpdateList)                                \
+	X(CChatService__GetFriendName)                                  \
+	X(CChatService__GetNumberOfFriends)                             \
+	X(CChatWindow__AddHistory)                                      \
+	X(CChatWindow__CChatWindow)                                     \
+	X(CChatWindow__Clear)                                           \
+	X(CChatWindow__WndNotification)                                 \
+	X(CChatWindowManager__CreateChatWindow)                         \
+	X(CChatWindowManager__FreeChatWindow)                           \
+	X(CChatWindowManager__GetRGBAFromIndex)                         \
+	X(CChatWindowManager__InitContextMenu)                          \
+	X(CChatWindowManager__SetLockedActiveChatWindow)                \
+	X(CColorPickerWnd__Open)                                        \
+	X(CComboWnd__DeleteAll)                                         \
+	X(CComboWnd__Draw)                                              \
+	X(CComboWnd__GetChoiceText)                                     \
+	X(CComboWnd__GetCurChoice)                                      \
+	X(CComboWnd__GetCurChoiceText)                                  \
+	X(CComboWnd__GetItemCount)                                      \
+	X(CComboWnd__GetListRect)                                       \
+	X(CComboWnd__InsertChoice)                                      \
+	X(CComboWnd__InsertChoiceAtIndex)                               \
+	X(CComboWnd__SetChoice)                                         \
+	X(CComboWnd__SetColors)                                         \
+	X(CContainerMgr__CloseContainer)                                \
+	X(CContainerMgr__OpenContainer)                                 \
+	X(CContainerMgr__OpenExperimentContainer)                       \
+	X(CContainerWnd__HandleCombine)                                 \
+	X(CContainerWnd__SetContainer)                                  \
+	X(CContainerWnd__vftable)                                       \
+	X(CContextMenu__AddMenuItem)                                    \
+	X(CContextMenu__AddSeparator)                                   \
+	X(CContextMenu__CheckMenuItem)                                  \
+	X(CContextMenu__RemoveAllMenuItems)                             \
+	X(CContextMenu__RemoveMenuItem)                                 \
+	X(CContextMenu__SetMenuItem)                                    \
+	X(CContextMenuManager__AddMenu)                                 \
+	X(CContextMenuManager__CreateDefaultMenu)                       \
+	X(CContextMenuManager__Flush)                                   \
+	X(CContextMenuManager__PopupMenu)                               \
+	X(CContextMenuManager__RemoveMenu)                              \
+	X(CCursorAttachment__AttachToCursor)                            \
+	X(CCursorAttachment__IsOkToActivate)                            \
+	X(CCursorAttachment__RemoveAttachment)                          \
+	X(CDBStr__GetString)                                            \
+	X(CDisplay__cameraType)                                         \
+	X(CDisplay__CleanGameUI)                                        \
+	X(CDisplay__GetClickedActor)                                    \
+	X(CDisplay__GetFloorHeight)                                     \
+	X(CDisplay__GetUserDefinedColor)                                \
+	X(CDisplay__InitCharSelectUI)                                   \
+	X(CDisplay__PreZoneMainUI)                                      \
+	X(CDisplay__RealRender_World)                                   \
+	X(CDisplay__ReloadUI)                                           \
+	X(CDisplay__RestartUI)                                          \
+	X(CDisplay__SetViewActor)                                       \
+	X(CDisplay__ToggleScreenshotMode)                               \
+	X(CDisplay__TrueDistance)                                       \
+	X(CDisplay__WriteTextHD2)                                       \
+	X(CDisplay__ZoneMainUI)                                         \
+	X(CDistillerInfo__GetIDFromRecordNum)                           \
+	X(CDistillerInfo__Instance)                                     \
+	X(CEditBaseWnd__SetSel)                                         \
+	X(CEditWnd__DrawCaret)                                          \
+	X(CEditWnd__EnsureCaretVisible)                                 \
+	X(CEditWnd__GetCaretPt)                                         \
+	X(CEditWnd__GetCharIndexPt)                                     \
+	X(CEditWnd__GetDisplayString)                                   \
+	X(CEditWnd__GetHorzOffset)                                      \
+	X(CEditWnd__GetLineForPrintableChar)                            \
+	X(CEditWnd__GetSelStartPt)                                      \
+	X(CEditWnd__GetSTMLSafeText)                                    \
+	X(CEditWnd__PointFromPrintableChar)                             \
+	X(CEditWnd__ReplaceSelection)                                   \
+	X(CEditWnd__SelectableCharFromPoint)                            \
+	X(CEditWnd__SetEditable)                                        \
+	X(CEditWnd__SetWindowText)                                      \
+	X(CEQSuiteTextureLoader__CreateTexture)                         \
+	X(CEQSuiteTextureLoader__GetDefaultUIPath)                      \
+	X(CEQSuiteTextureLoader__GetTexture)                            \
+	X(CEverQuest__ClickedPlayer)                                    \
+	X(CEverQuest__CreateTargetIndicator)                            \
+	X(CEverQuest__DoPercentConvert)                                 \
+	X(CEverQuest__DoTellWindow)                                     \
+	X(CEverQuest__DropHeldItemOnGround)                             \
+	X(CEverQuest__dsp_chat)                                         \
+	X(CEverQuest__Emote)                                            \
+	X(CEverQuest__GetBodyTypeDesc)                                  \
+	X(CEverQuest__GetClassDesc)                                     \
+	X(CEverQuest__GetClassThreeLetterCode)                          \
+	X(CEverQuest__GetDeityDesc)                                     \
+	X(CEverQuest__GetLangDesc)                                      \
+	X(CEverQuest__GetRaceDesc)                                      \
+	X(CEverQuest__InterpretCmd)                                     \
+	X(CEverQuest__IssuePetCommand)                                  \
+	X(CEverQuest__LeftClickedOnPlayer)                              \
+	X(CEverQuest__LMouseUp)                                         \
+	X(CEverQuest__OutputTextToLog)                                  \
+	X(CEverQuest__ReportSuccessfulHeal)                             \
+	X(CEverQuest__ReportSuccessfulHit)                              \
+	X(CEverQuest__RightClickedOnPlayer)                             \
+	X(CEverQuest__RMouseUp)                                         \
+	X(CEverQuest__SetGameState)                                     \
+	X(CEverQuest__trimName)                                         \
+	X(CEverQuest__UPCNotificationFlush)                             \
+	X(CFindItemWnd__PickupSelectedItem)                             \
+	X(CFindItemWnd__Update)                                         \
+	X(CFindItemWnd__WndNotification)                                \
+	X(CGaugeWnd__Draw)                                              \
+	X(CGroupWnd__UpdateDisplay)                                     \
+	X(CGroupWnd__WndNotification)                                   \
+	X(CGuild__FindMemberByName)                                     \
+	X(CGuild__GetGuildName)                                         \
+	X(CharacterBase__GetItemByGlobalIndex)                          \
+	X(CharacterBase__GetItemByGlobalIndex1)                         \
+	X(CharacterBase__IsExpansionFlag)                               \
+	X(CharacterZoneClient__BardCastBard)                            \
+	X(CharacterZoneClient__CalcAffectChange)                        \
+	X(CharacterZoneClient__CalcAffectChangeGeneric)                 \
+	X(CharacterZoneClient__CanMedOnHorse)                           \
+	X(CharacterZoneClient__CanUseItem)                              \
+	X(CharacterZoneClient__CanUseMemorizedSpellSlot)                \
+	X(CharacterZoneClient__CastSpell)                               \
+	X(CharacterZoneClient__CharacterZoneClient)                     \
+	X(CharacterZoneClient__Cur_HP)                                  \
+	X(CharacterZoneClient__Cur_Mana)                                \
+	X(CharacterZoneClient__FindAffectSlot)                          \
+	X(CharacterZoneClient__GetAdjustedSkill)                        \
+	X(CharacterZoneClient__GetBaseSkill)                            \
+	X(CharacterZoneClient__GetCastingTimeModifier)                  \
+	X(CharacterZoneClient__GetCurrentMod)                           \
+	X(CharacterZoneClient__GetCursorItemCount)                      \
+	X(CharacterZoneClient__GetEnduranceRegen)                       \
+	X(CharacterZoneClient__GetFirstEffectSlot)                      \
+	X(CharacterZoneClient__GetFocusCastingTimeModifier)             \
+	X(CharacterZoneClient__GetFocusDurationMod)                     \
+	X(CharacterZoneClient__GetHPRegen)                              \
+	X(CharacterZoneClient__GetItemCountInInventory)                 \
+	X(CharacterZoneClient__GetItemCountWorn)                        \
+	X(CharacterZoneClient__GetLastEffectSlot)                       \
+	X(CharacterZoneClient__GetManaRegen)                            \
+	X(CharacterZoneClient__GetModCap)                               \
+	X(CharacterZoneClient__GetOpenEffectSlot)                       \
+	X(CharacterZoneClient__GetPctModAndMin)                         \
+	X(CharacterZoneClient__GetPCSpellAffect)                        \
+	X(CharacterZoneClient__HasSkill)                                \
+	X(CharacterZoneClient__HitBySpell)                              \
+	X(CharacterZoneClient__IsStackBlocked)                          \
+	X(CharacterZoneClient__MakeMeVisible)                           \
+	X(CharacterZoneClient__Max_Endurance)                           \
+	X(CharacterZoneClient__Max_HP)                                  \
+	X(CharacterZoneClient__Max_Mana)                                \
+	X(CharacterZoneClient__NotifyPCAffectChange)                    \
+	X(CharacterZoneClient__RemovePCAffectex)                        \
+	X(CharacterZoneClient__SpellDuration)                           \
+	X(CharacterZoneClient__TotalEffect)                             \
+	X(CharacterZoneClient__UseSkill)                                \
+	X(ChatManagerClient__Instance)                                  \
+	X(CHelpWnd__SetFile)                                            \
+	X(CHotButton__SetButtonSize)                                    \
+	X(CHotButton__SetCheck)                                         \
+	X(CHotButtonWnd__DoHotButton)                                   \
+	X(CInvSlot__GetItemBase)                                        \
+	X(CInvSlot__HandleRButtonUp)                                    \
+	X(CInvSlot__SliderComplete)                                     \
+	X(CInvSlot__UpdateItem)                                         \
+	X(CInvSlotMgr__FindInvSlot)                                     \
+	X(CInvSlotMgr__MoveItem)                                        \
+	X(CInvSlotMgr__SelectSlot)                                      \
+	X(CInvSlotWnd__CInvSlotWnd)                                     \
+	X(CItemDisplayManager__CreateWindowInstance)                    \
+	X(CItemDisplayWnd__InsertAugmentRequest)                        \
+	X(CItemDisplayWnd__RemoveAugmentRequest)                        \
+	X(CItemDisplayWnd__RequestConvertItem)                          \
+	X(CItemDisplayWnd__SetItem)                                     \
+	X(CItemDisplayWnd__UpdateStrings)                               \
+	X(CKeyRingWnd__ExecuteRightClick)                               \
+	X(CLabel__UpdateText)                                           \
+	X(CLargeDialogWnd__Open)                                        \
+	X(ClientSOIManager__GetSingleton)                               \
+	X(CListWnd__AddColumn)                                          \
+	X(CListWnd__AddColumn1)                                         \
+	X(CListWnd__AddLine)                                            \
+	X(CListWnd__AddString)                                          \
+	X(CListWnd__CalculateCustomWindowPositions)                     \
+	X(CListWnd__CalculateFirstVisibleLine)                          \
+	X(CListWnd__CalculateVSBRange)                                  \
+	X(CListWnd__ClearAllSel)                                        \
+	X(CListWnd__ClearSel)                                           \
+	X(CListWnd__CListWnd)                                           \
+	X(CListWnd__CloseAndUpdateEditWindow)                           \
+	X(CListWnd__Compare)                                            \
+	X(CListWnd__dCListWnd)                                          \
+	X(CListWnd__Draw)                                               \
+	X(CListWnd__DrawColumnSeparators)                               \
+	X(CListWnd__DrawHeader)                                         \
+	X(CListWnd__DrawItem)                                           \
+	X(CListWnd__DrawLine)                                           \
+	X(CListWnd__DrawSeparator)                                      \
+	X(CListWnd__EnableLine)                                         \
+	X(CListWnd__EnsureVisible)                                      \
+	X(CListWnd__ExtendSel)                                          \
+	X(CListWnd__GetColumnMinWidth)                                  \
+	X(CListWnd__GetColumnWidth)                                     \
+	X(CListWnd__GetCurSel)                                          \
+	X(CListWnd__GetItemData)                                        \
+	X(CListWnd__GetItemHeight)                                      \
+	X(CListWnd__GetItemRect)                                        \
+	X(CListWnd__GetItemText)                                        \
+	X(CListWnd__GetItemWnd)                                         \
+	X(CListWnd__GetSelList)                                         \
+	X(CListWnd__GetSeparatorRect)                                   \
+	X(CListWnd__InsertLine)                                         \
+	X(CListWnd__RemoveLine)                                         \
+	X(CListWnd__SetColors)                                          \
+	X(CListWnd__SetColumnJustification)                             \
+	X(CListWnd__SetColumnLabel)                                     \
+	X(CListWnd__SetColumnsSizable)                                  \
+	X(CListWnd__SetColumnWidth)                                     \
+	X(CListWnd__SetCurSel)                                          \
+	X(CListWnd__SetItemColor)                                       \
+	X(CListWnd__SetItemData)                                        \
+	X(CListWnd__SetItemIcon)                                        \
+	X(CListWnd__SetItemText)                                        \
+	X(CListWnd__SetItemWnd)                                         \
+	X(CListWnd__SetVScrollPos)                                      \
+	X(CListWnd__Sort)                                               \
+	X(CListWnd__ToggleSel)                                          \
+	X(CListWnd__vftable)                                            \
+	X(CLootWnd__LootAll)                                            \
+	X(CLootWnd__RequestLootSlot)                                    \
+	X(CMapViewWnd__CMapViewWnd)                                     \
+	X(CMemoryMappedFile__SetFile)                                   \
+	X(CMerchantWnd__DisplayBuyOrSellPrice)                          \
+	X(CMerchantWnd__PurchasePageHandler__RequestGetItem)            \
+	X(CMerchantWnd__PurchasePageHandler__RequestPutItem)            \
+	X(CMerchantWnd__PurchasePageHandler__UpdateList)                \
+	X(CMerchantWnd__SelectBuySellSlot)                              \
+	X(COptionsWnd__FillChatFilterList)                              \
+	X(CPacketScrambler__hton)                                       \
+	X(CPacketScrambler__ntoh)                                       \
+	X(CPageWnd__FlashTab)                                           \
+	X(CPageWnd__SetTabText)                                         \
+	X(CQuantityWnd__Open)                                           \
+	X(CResolutionHandler__GetWindowedStyle)                         \
+	X(CResolutionHandler__UpdateResolution)                         \
+	X(CScreenPieceTemplate__IsType)                                 \
+	X(CSidlManager__CreateHotButtonWnd)                             \
+	X(CSidlManager__CreateXWnd)                                     \
+	X(CSidlManagerBase__CreateXWnd)                                 \
+	X(CSidlManagerBase__CreateXWndFromTemplate)                     \
+	X(CSidlManagerBase__CreateXWndFromTemplate1)                    \
+	X(CSidlManagerBase__FindAnimation1)                             \
+	X(CSidlManagerBase__FindButtonDrawTemplate)                     \
+	X(CSidlManagerBase__FindScreenPieceTemplate)                    \
+	X(CSidlManagerBase__FindScreenPieceTemplate1)                   \
+	X(CSidlScreenWnd__CalculateHSBRange)                            \
+	X(CSidlScreenWnd__CalculateVSBRange)                            \
+	X(CSidlScreenWnd__ConvertToRes)                                 \
+	X(CSidlScreenWnd__CreateChildrenFromSidl)                       \
+	X(CSidlScreenWnd__CSidlScreenWnd1)                              \
+	X(CSidlScreenWnd__CSidlScreenWnd2)                              \
+	X(CSidlScreenWnd__dCSidlScreenWnd)                              \
+	X(CSidlScreenWnd__DrawSidlPiece)                                \
+	X(CSidlScreenWnd__EnableIniStorage)                             \
+	X(CSidlScreenWnd__GetChildItem)                                 \
+	X(CSidlScreenWnd__GetSidlPiece)                                 \
+	X(CSidlScreenWnd__Init1)                                        \
+	X(CSidlScreenWnd__LoadIniListWnd)                               \
+	X(CSidlScreenWnd__LoadSidlScreen)                               \
+	X(CSidlScreenWnd__m_layoutCopy)                                 \
+	X(CSidlScreenWnd__StoreIniVis)                                  \
+	X(CSidlScreenWnd__vftable)                                      \
+	X(CSkillMgr__GetNameToken)                                      \
+	X(CSkillMgr__GetSkillCap)                                       \
+	X(CSkillMgr__IsActivatedSkill)                                  \
+	X(CSkillMgr__IsAvailable)                                       \
+	X(CSkillMgr__IsCombatSkill)                                     \
+	X(CSkillMgr__GetSkillTimerDuration)                             \
+	X(CSkillMgr__GetSkillLastUsed)                                  \
+	X(CSliderWnd__GetValue)                                         \
+	X(CSliderWnd__SetNumTicks)                                      \
+	X(CSliderWnd__SetValue)                                         \
+	X(CSpellBookWnd__MemorizeSet)                                   \
+	X(CSpellDisplayWnd__SetSpell)                                   \
+	X(CSpellDisplayWnd__UpdateStrings)                              \
+	X(CStmlWnd__AppendSTML)                                         \
+	X(CStmlWnd__CalculateHSBRange)                                  \
+	X(CStmlWnd__CalculateVSBRange)                                  \
+	X(CStmlWnd__FastForwardToEndOfTag)                              \
+	X(CStmlWnd__ForceParseNow)                                      \
+	X(CStmlWnd__GetVisibleText)                                     \
+	X(CStmlWnd__MakeStmlColorTag)                                   \
+	X(CStmlWnd__MakeWndNotificationTag)                             \
+	X(CStmlWnd__SetSTMLText)                                        \
+	X(CStmlWnd__StripFirstSTMLLines)                                \
+	X(CStmlWnd__UpdateHistoryString)                                \
+	X(CTabWnd__Draw)                                                \
+	X(CTabWnd__DrawCurrentPage)                                     \
+	X(CTabWnd__DrawTab)                                             \
+	X(CTabWnd__GetTabRect)                                          \
+	X(CTabWnd__InsertPage)                                          \
+	X(CTabWnd__RemovePage)                                          \
+	X(CTabWnd__SetPage)                                             \
+	X(CTabWnd__UpdatePage)                                          \
+	X(CTargetManager__Get)                                          \
+	X(CTargetWnd__HandleBuffRemoveRequest)                          \
+	X(CTargetWnd__RefreshTargetBuffs)                               \
+	X(CTargetWnd__WndNotification)                                  \
+	X(CTaskManager__GetElementDescription)                          \
+	X(CTaskManager__GetEntry)                                       \
+	X(CTaskManager__GetTaskStatus)                                  \
+	X(CTaskWnd__UpdateTaskTimers)                                   \
+	X(CTextOverlay__DisplayText)                                    \
+	X(CTextureAnimation__Draw)                                      \
+	X(CTextureAnimation__SetCurCell)                                \
+	X(CTextureFont__DrawWrappedText)                                \
+	X(CTextureFont__DrawWrappedText1)                               \
+	X(CTextureFont__DrawWrappedText2)                               \
+	X(CTextureFont__GetHeight)                                      \
+	X(CTextureFont__GetTextExtent)                                  \
+	X(CTribute__GetActiveFavorCost)                                 \
+	X(CUnSerializeBuffer__GetString)                                \
+	X(CWndDisplayManager__FindWindow)                               \
+	X(CXMLDataManager__GetXMLData)                                  \
+	X(CXMLSOMDocumentBase__XMLRead)                                 \
+	X(CXStr__gCXStrAccess)                                          \
+	X(CXStr__gFreeLists)                                            \
+	X(CXWnd__BringToTop)                                            \
+	X(CXWnd__ClrFocus)                                              \
+	X(CXWnd__CXWnd)                                                 \
+	X(CXWnd__dCXWnd)                                                \
+	X(CXWnd__Destroy)                                               \
+	X(CXWnd__DoAllDrawing)                                          \
+	X(CXWnd__DrawColoredRect)                                       \
+	X(CXWnd__DrawTooltip)                                           \
+	X(CXWnd__DrawTooltipAtPoint)                                    \
+	X(CXWnd__GetChildItem)                                          \
+	X(CXWnd__GetChildWndAt)                                         \
+	X(CXWnd__GetClientClipRect)                                     \
+	X(CXWnd__GetClientRect)                                         \
+	X(CXWnd__GetRelativeRect)                                       \
+	X(CXWnd__GetScreenClipRect)                                     \
+	X(CXWnd__GetScreenRect)                                         \
+	X(CXWnd__GetTooltipRect)                                        \
+	X(CXWnd__IsActive)                                              \
+	X(CXWnd__IsDescendantOf)                                        \
+	X(CXWnd__IsReallyVisible)                                       \
+	X(CXWnd__IsType)                                                \
+	X(CXWnd__Minimize)                                              \
+	X(CXWnd__ProcessTransition)                                     \
+	X(CXWnd__Resize)                                                \
+	X(CXWnd__Right)                                                 \
+	X(CXWnd__SetFocus)                                              \
+	X(CXWnd__SetFont)                                               \
+	X(CXWnd__SetKeyTooltip)                                         \
+	X(CXWnd__SetMouseOver)                                          \
+	X(CXWnd__SetParent)                                             \
+	X(CXWnd__StartFade)                                             \
+	X(CXWnd__vftable)                                               \
+	X(CXWndManager__DestroyAllWindows)                              \
+	X(CXWndManager__DrawCursor)                                     \
+	X(CXWndManager__DrawWindows)                                    \
+	X(CXWndManager__GetKeyboardFlags)                               \
+	X(CXWndManager__HandleKeyboardMsg)                              \
+	X(CXWndManager__RemoveWnd)                                      \
+	X(DrawNetStatus)                                                \
+	X(EQ_LoadingS__Array)                                           \
+	X(EQ_LoadingS__SetProgressBar)                                  \
+	X(EQ_Spell__GetSpellAffectByIndex)                              \
+	X(EQ_Spell__GetSpellAffectBySlot)                               \
+	X(EQ_Spell__GetSpellLevelNeeded)                                \
+	X(EQ_Spell__IsDegeneratingLevelMod)                             \
+	X(EQ_Spell__IsSPAIgnoredByStacking)                             \
+	X(EQ_Spell__IsSPAStacking)                                      \
+	X(EQ_Spell__SpellAffectBase)                                    \
+	X(EQ_Spell__SpellAffects)                                       \
+	X(EQGroundItemListManager__Instance)                            \
+	X(EQItemList__add_item)                                         \
+	X(EQItemList__delete_item)                                      \
+	X(EQItemList__EQItemList)                                       \
+	X(EQItemList__FreeItemList)                                     \
+	X(EQPlacedItemManager__GetItemByGuid)                           \
+	X(EQPlacedItemManager__GetItemByRealEstateAndRealEstateItemIds) \
+	X(EQPlacedItemManager__Instance)                                \
+	X(EqSoundManager__PlayScriptMp3)                                \
+	X(EqSoundManager__SoundAssistPlay)                              \
+	X(EqSoundManager__WaveInstancePlay)                             \
+	X(EqSoundManager__WavePlay)                                     \
+	X(EQSpellStrings__GetString)                                    \
+	X(EQSwitch__UseSwitch)                                          \
+	X(FactionManagerClient__HandleFactionMessage)                   \
+	X(FactionManagerClient__Instance)                               \
+	X(FreeTargetTracker__CastSpell)                                 \
+	X(FreeToPlayClient__Instance)                                   \
+	X(FreeToPlayClient__RestrictionInfo)                            \
+	X(IconCache__GetIcon)                                           \
+	X(ItemBase__CanGemFitInSlot)                                    \
+	X(ItemBase__CreateItemTagString)                                \
+	X(ItemBase__GetImageNum)                                        \
+	X(ItemBase__GetItemValue)                                       \
+	X(ItemBase__IsEmpty)                                            \
+	X(ItemBase__IsKeyRingItem)                                      \
+	X(ItemBase__IsLore)                                             \
+	X(ItemBase__IsLoreEquipped)                                     \
+	X(ItemBase__ValueSellMerchant)                                  \
+	X(ItemClient__CanDrop)                                          \
+	X(ItemClient__CanGoInBag)                                       \
+	X(ItemClient__CreateItemClient)                                 \
+	X(ItemClient__dItemClient)                                      \
+	X(KeyCombo__GetTextDescription)                                 \
+	X(KeypressHandler__AttachAltKeyToEqCommand)                     \
+	X(KeypressHandler__AttachKeyToEqCommand)                        \
+	X(KeypressHandler__ClearCommandStateArray)                      \
+	X(KeypressHandler__Get)                                         \
+	X(KeypressHandler__HandleKeyDown)                               \
+	X(KeypressHandler__HandleKeyUp)                                 \
+	X(KeypressHandler__SaveKeymapping)                              \
+	X(LootFiltersManager__AddItemLootFilter)                        \
+	X(LootFiltersManager__GetItemFilterData)                        \
+	X(LootFiltersManager__RemoveItemLootFilter)                     \
+	X(LootFiltersManager__SetItemLootFilter)                        \
+	X(MapViewMap__Clear)                                            \
+	X(MapViewMap__SetZoom)                                          \
+	X(MapViewMap__vftable)                                          \
+	X(MercenaryAlternateAdvancementManagerClient__BuyAbility)       \
+	X(MercenaryAlternateAdvancementManagerClient__Instance)         \
+	X(msg_new_text)                                                 \
+	X(msg_spell_worn_off)                                           \
+	X(msgTokenText)                                                 \
+	X(MultipleItemMoveManager__ProcessMove)                         \
+	X(PcBase__GetAlternateAbilityId)                                \
+	X(PcBase__GetCombatAbility)                                     \
+	X(PcBase__GetCombatAbilityTimer)                                \
+	X(PcBase__GetItemContainedRealEstateIds)                        \
+	X(PcBase__GetNonArchivedOwnedRealEstates)                       \
+	X(PcClient__AlertInventoryChanged)                              \
+	X(PcClient__GetConLevel)                                        \
+	X(PcClient__GetMeleeSpellFromSkillIndex)                        \
+	X(PcClient__HasLoreItem)                                        \
+	X(PcZoneClient__BandolierSwap)                                  \
+	X(PcZoneClient__CanEquipItem)                                   \
+	X(PcZoneClient__DestroyHeldItemOrMoney)                         \
+	X(PcZoneClient__doCombatAbility)                                \
+	X(PcZoneClient__GetItemByID)                                    \
+	X(PcZoneClient__GetItemRecastTimer)                             \
+	X(PcZoneClient__GetPcSkillLimit)                                \
+	X(PcZoneClient__HasAlternateAbility)                            \
+	X(PcZoneClient__RemoveBuffEffect)                               \
+	X(PcZoneClient__RemoveMyAffect)                                 \
+	X(PcZoneClient__RemovePetEffect)                                \
+	X(pinstLootFiltersManager)                                      \
+	X(PlayerBase__CanSee)                                           \
+	X(PlayerBase__CanSee1)                                          \
+	X(PlayerBase__GetVisibilityLineSegment)                         \
+	X(PlayerBase__HasProperty)                                      \
+	X(PlayerBase__IsTargetable)                                     \
+	X(PlayerClient__ChangeBoneStringSprite)                         \
+	X(PlayerClient__GetPcClient)                                    \
+	X(PlayerClient__SetNameSpriteState)                             \
+	X(PlayerClient__SetNameSpriteTint)                              \
+	X(PlayerManagerBase__PrepForDestroyPlayer)                      \
+	X(PlayerManagerClient__CreatePlayer)                            \
+	X(PlayerManagerClient__GetPlayerFromPartialName)                \
+	X(PlayerManagerClient__GetSpawnByID)                            \
+	X(PlayerManagerClient__GetSpawnByName)                          \
+	X(PlayerPointManager__GetAltCurrency)                           \
+	X(PlayerZoneClient__ChangeHeight)                               \
+	X(PlayerZoneClient__DoAttack)                                   \
+	X(PlayerZoneClient__GetLevel)                                   \
+	X(PlayerZoneClient__IsValidTeleport)                            \
+	X(PlayerZoneClient__LegalPlayerRace)                            \
+	X(ProfileManager__GetCurrentProfile)                            \
+	X(RealEstateManagerClient__Instance)                            \
+	X(SpellManager__GetSpellByGroupAndRank)                         \
+	X(Spellmanager__LoadTextSpells)                                 \
+	X(StringTable__getString)                                       \
+	X(Teleport_Table_Size)                                          \
+	X(Teleport_Table)                                               \
+	X(UdpConnection__GetStats)                                      \
+	X(Util__FastTime)                                               \
+	X(ZoneGuideManagerClient__Instance)
+
+// The offsets are 64-bit literals, the casts keep the brace initializers from narrowing on x86.
+#define DEFINE_EQGAME_OFFSET(var) uintptr_t var = static_cast<uintptr_t>(var##_x);
+#define REGISTER_EQGAME_OFFSET(var) { #var, &var, static_cast<uintptr_t>(var##_x), OffsetModule::EQGame },
+
+EQGAME_OFFSET_LIST(DEFINE_EQGAME_OFFSET)
+
+static constexpr OffsetDefinition s_eqgameOffsets[] = {
+	EQGAME_OFFSET_LIST(REGISTER_EQGAME_OFFSET)
+};
+
+#undef REGISTER_EQGAME_OFFSET
+#undef DEFINE_EQGAME_OFFSET
+
+void RelocateOffsets(const OffsetDefinition* definitions, size_t count, uintptr_t preferredBase, uintptr_t moduleBase)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		*definitions[i].variable = definitions[i].preferredAddress - preferredBase + moduleBase;
+	}
+}
+
+// Runs once, during static initialization, so that the offsets are usable by the time anything
+// outside of this file can see them.
+static const bool s_eqgameOffsetsRelocated = [] {
+	RelocateOffsets(s_eqgameOffsets, std::size(s_eqgameOffsets), EQGamePreferredAddress, EQGameBaseAddress);
+	return true;
+}();
+
+const OffsetDefinition* GetEQGameOffsetDefinitions(size_t& count)
+{
+	count = std::size(s_eqgameOffsets);
+	return s_eqgameOffsets;
+}
+
+const OffsetDefinition* FindOffsetDefinition(std::string_view name)
+{
+	for (const OffsetDefinition& definition : s_eqgameOffsets)
+	{
+		if (name == definition.name)
+			return &definition;
+	}
+
+	return nullptr;
+}
 
 //----------------------------------------------------------------------------
 // Instance Pointers
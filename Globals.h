@@ -55,7 +55,7 @@ EQLIB_VAR uintptr_t Kernel32BaseAddress;
 template <typename T, typename = std::enable_if_t<std::is_integral_v<T>, void>>
 inline uintptr_t FixEQGameOffset(T nOffset)
 {
-	return static_cast<uintptr_t>(nOffset) - static_cast<uintptr_t>(0x140000000) + EQGameBaseAddress;
+	return static_cast<uintptr_t>(nOffset) - EQGamePreferredAddress + EQGameBaseAddress;
 }
 
 template <typename T, typename = std::enable_if_t<std::is_integral_v<T>, void>>
@@ -74,6 +74,33 @@ inline uintptr_t FixEQMainOffset(T nOffset)
 #define INITIALIZE_EQGRAPHICS_OFFSET(var) uintptr_t var = FixEQGraphicsOffset(var##_x)
 #define INITIALIZE_EQMAIN_OFFSET(var) uintptr_t var = FixEQMainOffset(var##_x)
 
+enum class OffsetModule : uint8_t
+{
+	EQGame,
+	EQGraphics,
+	EQMain,
+};
+
+// An entry in the offset registry. |variable| holds |preferredAddress| until the registry is
+// relocated, and the address rebased to where the module was actually loaded after that.
+struct OffsetDefinition
+{
+	const char*  name;
+	uintptr_t*   variable;
+	uintptr_t    preferredAddress;
+	OffsetModule module;
+};
+
+// Returns the registry of eqgame.exe offsets, in the order they are defined in.
+EQLIB_OBJECT const OffsetDefinition* GetEQGameOffsetDefinitions(size_t& count);
+
+// Looks up a registered offset by name, e.g. "CXWnd__Show". Returns nullptr if there isn't one.
+EQLIB_OBJECT const OffsetDefinition* FindOffsetDefinition(std::string_view name);
+
+// Rebases every variable in |definitions| from |preferredBase| to |moduleBase| in one pass.
+EQLIB_OBJECT void RelocateOffsets(const OffsetDefinition* definitions, size_t count,
+	uintptr_t preferredBase, uintptr_t moduleBase);
+
 
 //============================================================================
 // Data
@@ -1147,6 +1174,27 @@ EQLIB_API bool CopyLayout(const CXStr& currlayout, const CXStr& newlayout, bool
 EQLIB_API uint32_t GetBufferCRC(const char* szBuffer, size_t bufferLength, int baseValue = 0);
 EQLIB_API uint32_t GetStringCRC(std::string_view);
 
+// The game's own GetBufferCRC. GetBufferCRC calls this until the native implementation is enabled.
+EQLIB_API uint32_t EQGetBufferCRC(const char* szBuffer, size_t bufferLength, int baseValue = 0);
+
+enum class BufferCRCImplementation
+{
+	Game,        // call into eqgame.exe
+	Table,       // slicing-by-8
+	CLMUL,       // PCLMULQDQ folding, falls back to the table for short buffers
+};
+
+EQLIB_API uint32_t GetBufferCRC_Table(const char* szBuffer, size_t bufferLength, int baseValue = 0);
+EQLIB_API uint32_t GetBufferCRC_CLMUL(const char* szBuffer, size_t bufferLength, int baseValue = 0);
+
+// Selects the implementation behind GetBufferCRC. Returns false if it isn't available.
+EQLIB_API bool SetBufferCRCImplementation(BufferCRCImplementation implementation);
+EQLIB_API BufferCRCImplementation GetBufferCRCImplementation();
+
+// Switches GetBufferCRC to the fastest native implementation. If |verifyAgainstGame| is set,
+// it is first checked against the game's version, and left alone if they disagree.
+EQLIB_API bool UseNativeBufferCRC(bool verifyAgainstGame = true);
+
 //----------------------------------------------------------------------------
 // FIXME: Remove these macros
 //#define indoor (((*EQADDR_ZONETYPE) == 0) || ((*EQADDR_ZONETYPE) == 3) || ((*EQADDR_ZONETYPE) == 4))
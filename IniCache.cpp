@@ -0,0 +1,348 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "IniCache.h"
+
+#include <cstdlib>
+
+namespace eqlib {
+
+static std::string_view TrimIniText(std::string_view text)
+{
+	size_t first = text.find_first_not_of(" \t\r");
+	if (first == std::string_view::npos)
+		return {};
+
+	size_t last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+static void AppendLower(std::string& out, std::string_view text)
+{
+	for (char ch : text)
+		out.push_back((ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch);
+}
+
+//============================================================================
+// IniFile
+//============================================================================
+
+IniFile::IniFile(const std::string& path)
+	: m_path(path)
+{
+}
+
+IniFile::~IniFile()
+{
+	Flush();
+}
+
+std::string IniFile::MakeKey(std::string_view section, std::string_view key)
+{
+	// Section names can't contain a line break, so it can't be mistaken for part of one.
+	std::string result;
+	result.reserve(section.length() + key.length() + 1);
+
+	AppendLower(result, section);
+	result.push_back('\n');
+	AppendLower(result, key);
+
+	return result;
+}
+
+void IniFile::Parse(std::string_view text)
+{
+	m_values.clear();
+
+	std::string section;
+	size_t pos = 0;
+
+	while (pos < text.length())
+	{
+		size_t end = text.find('\n', pos);
+		if (end == std::string_view::npos)
+			end = text.length();
+
+		std::string_view line = TrimIniText(text.substr(pos, end - pos));
+		pos = end + 1;
+
+		if (line.empty() || line[0] == ';')
+			continue;
+
+		if (line[0] == '[')
+		{
+			size_t close = line.find(']');
+			section = std::string(TrimIniText(line.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1)));
+			continue;
+		}
+
+		size_t equals = line.find('=');
+		if (equals == std::string_view::npos)
+			continue;
+
+		std::string_view key = TrimIniText(line.substr(0, equals));
+		std::string_view value = TrimIniText(line.substr(equals + 1));
+
+		if (value.length() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+			value = value.substr(1, value.length() - 2);
+
+		// Like the profile API, the first occurrence of a key wins.
+		m_values.emplace(MakeKey(section, key), std::string(value));
+	}
+}
+
+bool IniFile::GetFileStamp(uint64_t& writeTime, uint64_t& size) const
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExA(m_path.c_str(), GetFileExInfoStandard, &data))
+		return false;
+
+	writeTime = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+	return true;
+}
+
+bool IniFile::Load()
+{
+	// The stamp is only kept once the file has been read, so a failed read is tried again on
+	// the next check instead of looking up to date.
+	uint64_t writeTime = 0, size = 0;
+	bool exists = GetFileStamp(writeTime, size);
+
+	if (!exists || size == 0)
+	{
+		Parse({});
+	}
+	else
+	{
+		// Opening can fail with a sharing violation while the game is writing the file.
+		HANDLE hFile = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		// The file may have changed size since it was stamped, only the size of the open file
+		// says how much of it the view covers.
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(hFile, &fileSize))
+		{
+			CloseHandle(hFile);
+			return false;
+		}
+
+		if (fileSize.QuadPart == 0)
+		{
+			CloseHandle(hFile);
+			Parse({});
+		}
+		else
+		{
+			HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			const char* view = hMapping ? static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+
+			if (view)
+			{
+				Parse(std::string_view(view, static_cast<size_t>(fileSize.QuadPart)));
+				UnmapViewOfFile(view);
+			}
+
+			if (hMapping)
+				CloseHandle(hMapping);
+			CloseHandle(hFile);
+
+			if (!view)
+				return false;
+		}
+	}
+
+	m_exists = exists;
+	m_writeTime = writeTime;
+	m_size = size;
+	++m_loads;
+
+	// Values that haven't been written yet still win over what's in the file.
+	for (const auto& [flatKey, pending] : m_pending)
+		m_values[flatKey] = pending.value;
+
+	return true;
+}
+
+bool IniFile::Refresh()
+{
+	m_lastCheck = GetTickCount64();
+
+	uint64_t writeTime = 0, size = 0;
+	bool exists = GetFileStamp(writeTime, size);
+
+	if (m_loads != 0 && exists == m_exists && writeTime == m_writeTime && size == m_size)
+		return false;
+
+	return Load();
+}
+
+void IniFile::CheckForChanges()
+{
+	if (m_lastCheck == 0 || GetTickCount64() - m_lastCheck >= m_refreshInterval)
+		Refresh();
+}
+
+std::string_view IniFile::GetValue(std::string_view section, std::string_view key)
+{
+	CheckForChanges();
+
+	auto iter = m_values.find(MakeKey(section, key));
+	if (iter == m_values.end())
+		return {};
+
+	return iter->second;
+}
+
+int IniFile::GetValues(std::string_view section, const std::string_view* keys, size_t count, std::string_view* values)
+{
+	CheckForChanges();
+
+	std::string flatKey;
+	AppendLower(flatKey, section);
+	flatKey.push_back('\n');
+	size_t prefixLength = flatKey.length();
+
+	int found = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		flatKey.resize(prefixLength);
+		AppendLower(flatKey, keys[i]);
+
+		auto iter = m_values.find(flatKey);
+		if (iter != m_values.end())
+		{
+			values[i] = iter->second;
+			++found;
+		}
+		else
+		{
+			values[i] = {};
+		}
+	}
+
+	return found;
+}
+
+std::string IniFile::GetString(std::string_view section, std::string_view key, std::string_view defaultValue)
+{
+	std::string_view value = GetValue(section, key);
+	return std::string(value.data() ? value : defaultValue);
+}
+
+int IniFile::GetInt(std::string_view section, std::string_view key, int defaultValue)
+{
+	// Values are stored as std::string, so the view is null terminated.
+	std::string_view value = GetValue(section, key);
+	return value.data() ? static_cast<int>(strtol(value.data(), nullptr, 10)) : defaultValue;
+}
+
+float IniFile::GetFloat(std::string_view section, std::string_view key, float defaultValue)
+{
+	std::string_view value = GetValue(section, key);
+	return value.data() ? strtof(value.data(), nullptr) : defaultValue;
+}
+
+bool IniFile::GetBool(std::string_view section, std::string_view key, bool defaultValue)
+{
+	std::string_view value = GetValue(section, key);
+	if (!value.data())
+		return defaultValue;
+
+	if (mq::ci_equals(value, "true") || mq::ci_equals(value, "on") || mq::ci_equals(value, "yes"))
+		return true;
+
+	if (mq::ci_equals(value, "false") || mq::ci_equals(value, "off") || mq::ci_equals(value, "no"))
+		return false;
+
+	return strtol(value.data(), nullptr, 10) != 0;
+}
+
+void IniFile::SetString(std::string_view section, std::string_view key, std::string_view value)
+{
+	CheckForChanges();
+
+	std::string flatKey = MakeKey(section, key);
+	m_values[flatKey] = std::string(value);
+
+	PendingWrite& pending = m_pending[flatKey];
+	pending.section = std::string(section);
+	pending.key = std::string(key);
+	pending.value = std::string(value);
+}
+
+int IniFile::Flush()
+{
+	if (m_pending.empty())
+		return 0;
+
+	// Writes that fail stay queued for the next Flush, the value in memory already has them.
+	int written = 0;
+	for (auto iter = m_pending.begin(); iter != m_pending.end();)
+	{
+		const PendingWrite& pending = iter->second;
+
+		if (WritePrivateProfileStringA(pending.section.c_str(), pending.key.c_str(), pending.value.c_str(), m_path.c_str()))
+		{
+			iter = m_pending.erase(iter);
+			++written;
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	// Read the file back instead of adopting its new stamp: another process may have written to
+	// it as well, and its changes would go unseen until the file changed again. If the load
+	// fails the old stamp stays, so the next check tries again.
+	if (written != 0 && Load())
+		m_lastCheck = GetTickCount64();
+
+	return written;
+}
+
+//============================================================================
+// IniCache
+//============================================================================
+
+IniFile& IniCache::GetFile(const std::string& path)
+{
+	std::unique_ptr<IniFile>& file = m_files[path];
+	if (!file)
+		file = std::make_unique<IniFile>(path);
+
+	return *file;
+}
+
+int IniCache::FlushAll()
+{
+	int written = 0;
+	for (auto& [path, file] : m_files)
+		written += file->Flush();
+
+	return written;
+}
+
+void IniCache::Clear()
+{
+	FlushAll();
+	m_files.clear();
+}
+
+} // namespace eqlib
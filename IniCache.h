@@ -0,0 +1,129 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Config.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace eqlib {
+
+// An ini file, read once and kept in memory.
+//
+// Every GetPrivateProfileString call opens, reads and parses the file again. IniFile maps the
+// file and parses it once into a hash keyed by section and key (both case insensitive), and
+// only parses it again when the file's size or write time changes. The check for changes is
+// done at most once per refresh interval.
+//
+// Values are looked up the way the profile API looks them up: surrounding whitespace is
+// trimmed, a value in matching quotes loses the quotes, and if a key appears twice in a section
+// the first one wins.
+//
+// Writes update the in-memory value right away and are queued. Repeated writes to the same key
+// are coalesced, and the queue is written out with the profile API by Flush, which keeps the
+// rest of the file as it was.
+class IniFile
+{
+public:
+	EQLIB_OBJECT IniFile(const std::string& path);
+	EQLIB_OBJECT ~IniFile();
+
+	IniFile(const IniFile&) = delete;
+	IniFile& operator=(const IniFile&) = delete;
+
+	const std::string& GetPath() const { return m_path; }
+
+	// Returns a view of the value, or a view with a null data() if the key doesn't exist. The
+	// view is valid until the next write or reload.
+	EQLIB_OBJECT std::string_view GetValue(std::string_view section, std::string_view key);
+
+	EQLIB_OBJECT std::string GetString(std::string_view section, std::string_view key, std::string_view defaultValue = {});
+	EQLIB_OBJECT int GetInt(std::string_view section, std::string_view key, int defaultValue = 0);
+	EQLIB_OBJECT float GetFloat(std::string_view section, std::string_view key, float defaultValue = 0.0f);
+	EQLIB_OBJECT bool GetBool(std::string_view section, std::string_view key, bool defaultValue = false);
+
+	// Looks up several keys of one section at once, filling |values| the same way GetValue would.
+	// Returns the number of keys that exist.
+	EQLIB_OBJECT int GetValues(std::string_view section, const std::string_view* keys, size_t count, std::string_view* values);
+
+	// Sets a value, to be written to the file by Flush.
+	EQLIB_OBJECT void SetString(std::string_view section, std::string_view key, std::string_view value);
+	void SetInt(std::string_view section, std::string_view key, int value) { SetString(section, key, std::to_string(value)); }
+	void SetBool(std::string_view section, std::string_view key, bool value) { SetString(section, key, value ? "1" : "0"); }
+
+	// Writes queued values to the file and reads it back, so changes made by others show up too.
+	// Values that fail to write stay queued. Returns the number of values written.
+	EQLIB_OBJECT int Flush();
+	size_t GetPendingWriteCount() const { return m_pending.size(); }
+
+	// Checks the file for changes right away, and reloads it if it did change.
+	EQLIB_OBJECT bool Refresh();
+
+	// How often, in milliseconds, lookups check the file for changes.
+	void SetRefreshInterval(uint32_t intervalMs) { m_refreshInterval = intervalMs; }
+
+	// Replaces the contents with |text|, parsed as an ini file. Used when loading, and handy for
+	// feeding the parser directly.
+	EQLIB_OBJECT void Parse(std::string_view text);
+
+	size_t GetValueCount() const { return m_values.size(); }
+	uint32_t GetLoadCount() const { return m_loads; }
+
+private:
+	struct PendingWrite
+	{
+		std::string section;
+		std::string key;
+		std::string value;
+	};
+
+	static std::string MakeKey(std::string_view section, std::string_view key);
+
+	void CheckForChanges();
+	bool Load();
+	bool GetFileStamp(uint64_t& writeTime, uint64_t& size) const;
+
+	std::string m_path;
+	std::unordered_map<std::string, std::string> m_values;
+	std::unordered_map<std::string, PendingWrite> m_pending;
+
+	uint64_t m_writeTime = 0;
+	uint64_t m_size = 0;
+	bool m_exists = false;
+	uint64_t m_lastCheck = 0;
+	uint32_t m_refreshInterval = 1000;
+	uint32_t m_loads = 0;
+};
+
+// Shares IniFile instances by path, so every reader of a file uses the same parsed copy.
+class IniCache
+{
+public:
+	// Returns the file for |path|, loading it the first time.
+	EQLIB_OBJECT IniFile& GetFile(const std::string& path);
+
+	// Flushes the queued writes of every file. Returns the number of values written.
+	EQLIB_OBJECT int FlushAll();
+
+	EQLIB_OBJECT void Clear();
+
+private:
+	std::unordered_map<std::string, std::unique_ptr<IniFile>> m_files;
+};
+
+} // namespace eqlib
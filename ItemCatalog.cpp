@@ -0,0 +1,425 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "ItemCatalog.h"
+
+#include <algorithm>
+#include <ctime>
+
+namespace eqlib {
+
+static constexpr uint32_t ITEM_CATALOG_MAGIC = 0x54414349; // 'ICAT'
+static constexpr uint32_t ITEM_CATALOG_VERSION = 1;
+
+#pragma pack(push, 1)
+struct ItemCatalogHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t definitionSize;
+	uint32_t reserved;
+};
+#pragma pack(pop)
+
+// Processes sharing a catalog serialize on a lock of one byte past anything that will ever be
+// written, so that holding it doesn't get in the way of reading the file.
+static constexpr DWORD ITEM_CATALOG_LOCK_OFFSET_HIGH = 0x7fffffff;
+
+static bool LockCatalogFile(HANDLE hFile)
+{
+	OVERLAPPED overlapped = {};
+	overlapped.OffsetHigh = ITEM_CATALOG_LOCK_OFFSET_HIGH;
+
+	return LockFileEx(hFile, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped) != FALSE;
+}
+
+static void UnlockCatalogFile(HANDLE hFile)
+{
+	OVERLAPPED overlapped = {};
+	overlapped.OffsetHigh = ITEM_CATALOG_LOCK_OFFSET_HIGH;
+
+	UnlockFileEx(hFile, 0, 1, 0, &overlapped);
+}
+
+static char ToLowerAscii(char ch)
+{
+	return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+// Lower cases an item name into |buffer|, which must be at least ITEM_NAME_LEN long.
+static std::string_view GetLowerName(const ItemDefinition& definition, char* buffer)
+{
+	size_t length = strnlen(definition.Name, ITEM_NAME_LEN);
+	for (size_t i = 0; i < length; ++i)
+		buffer[i] = ToLowerAscii(definition.Name[i]);
+
+	return std::string_view(buffer, length);
+}
+
+static uint32_t GetTrigram(std::string_view text, size_t pos)
+{
+	return (static_cast<uint32_t>(static_cast<uint8_t>(text[pos])) << 16)
+		| (static_cast<uint32_t>(static_cast<uint8_t>(text[pos + 1])) << 8)
+		| static_cast<uint8_t>(text[pos + 2]);
+}
+
+//============================================================================
+// ItemCatalog
+//============================================================================
+
+ItemCatalog::ItemCatalog()
+{
+}
+
+ItemCatalog::~ItemCatalog()
+{
+	Close();
+}
+
+bool ItemCatalog::Open(const std::string& path)
+{
+	Close();
+
+	// Other clients may have the same catalog open, they append under the lock as well.
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+		OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	if (!LockCatalogFile(hFile))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_path = path;
+	m_fileHandle = hFile;
+
+	bool opened = Load();
+	UnlockCatalogFile(hFile);
+
+	if (!opened)
+		Close();
+
+	return opened;
+}
+
+bool ItemCatalog::Load()
+{
+	HANDLE hFile = m_fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize))
+		return false;
+
+	ItemCatalogHeader header = {};
+	DWORD bytesRead = 0;
+	bool valid = fileSize.QuadPart >= static_cast<LONGLONG>(sizeof(header))
+		&& ReadFile(hFile, &header, sizeof(header), &bytesRead, nullptr)
+		&& bytesRead == sizeof(header)
+		&& header.magic == ITEM_CATALOG_MAGIC
+		&& header.version == ITEM_CATALOG_VERSION
+		&& header.definitionSize == sizeof(ItemDefinition);
+
+	uint64_t numRecords = 0;
+	LARGE_INTEGER end;
+
+	if (valid)
+	{
+		// A snapshot that was only partly written (the game went away mid write) is dropped, so
+		// that the next one starts where it belongs.
+		numRecords = (static_cast<uint64_t>(fileSize.QuadPart) - sizeof(header)) / sizeof(Record);
+		end.QuadPart = sizeof(header) + numRecords * sizeof(Record);
+	}
+	else
+	{
+		// New file, or one written for a different ItemDefinition. Start over.
+		header.magic = ITEM_CATALOG_MAGIC;
+		header.version = ITEM_CATALOG_VERSION;
+		header.definitionSize = sizeof(ItemDefinition);
+		header.reserved = 0;
+
+		LARGE_INTEGER start = {};
+		DWORD bytesWritten = 0;
+		if (!SetFilePointerEx(hFile, start, nullptr, FILE_BEGIN)
+			|| !WriteFile(hFile, &header, sizeof(header), &bytesWritten, nullptr)
+			|| bytesWritten != sizeof(header))
+		{
+			return false;
+		}
+
+		end.QuadPart = sizeof(header);
+	}
+
+	// Fails if another client has the old contents mapped, e.g. one built against a different
+	// ItemDefinition. Records appended after a leftover would be misaligned, so give up.
+	if (end.QuadPart != fileSize.QuadPart
+		&& (!SetFilePointerEx(hFile, end, nullptr, FILE_BEGIN) || !SetEndOfFile(hFile)))
+	{
+		return false;
+	}
+
+	if (numRecords > 0 && !Map(numRecords))
+		return false;
+
+	// Later snapshots of an item replace earlier ones.
+	for (size_t i = 0; i < m_numMapped; ++i)
+		Index(m_mapped[i]);
+
+	return true;
+}
+
+bool ItemCatalog::Append(const Record& record)
+{
+	HANDLE hFile = m_fileHandle;
+
+	if (!LockCatalogFile(hFile))
+		return false;
+
+	// Another client may have appended since, or stopped partway through a record. Anything
+	// past the last whole record is dropped before writing after it.
+	LARGE_INTEGER fileSize;
+	bool written = GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart >= static_cast<LONGLONG>(sizeof(ItemCatalogHeader));
+
+	if (written)
+	{
+		LARGE_INTEGER end;
+		end.QuadPart = sizeof(ItemCatalogHeader)
+			+ (fileSize.QuadPart - sizeof(ItemCatalogHeader)) / sizeof(Record) * sizeof(Record);
+
+		DWORD bytesWritten = 0;
+		written = SetFilePointerEx(hFile, end, nullptr, FILE_BEGIN)
+			&& (end.QuadPart == fileSize.QuadPart || SetEndOfFile(hFile))
+			&& WriteFile(hFile, &record, sizeof(Record), &bytesWritten, nullptr)
+			&& bytesWritten == sizeof(Record);
+	}
+
+	UnlockCatalogFile(hFile);
+	return written;
+}
+
+void ItemCatalog::Close()
+{
+	Unmap();
+
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = nullptr;
+	}
+
+	m_appended.clear();
+	m_items.clear();
+	m_trigrams.clear();
+}
+
+bool ItemCatalog::Map(uint64_t numRecords)
+{
+	HANDLE hMapping = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping)
+		return false;
+
+	const void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(hMapping);
+		return false;
+	}
+
+	m_mappingHandle = hMapping;
+	m_view = view;
+	m_mapped = reinterpret_cast<const Record*>(static_cast<const ItemCatalogHeader*>(view) + 1);
+	m_numMapped = static_cast<size_t>(numRecords);
+	return true;
+}
+
+void ItemCatalog::Unmap()
+{
+	if (m_view)
+	{
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+	}
+
+	m_mapped = nullptr;
+	m_numMapped = 0;
+
+	if (m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+}
+
+void ItemCatalog::Index(const Record& record)
+{
+	const Record*& latest = m_items[record.itemNumber];
+	const Record* previous = latest;
+	latest = &record;
+
+	char nameBuffer[ITEM_NAME_LEN];
+	std::string_view name = GetLowerName(*GetDefinition(record), nameBuffer);
+
+	// The trigrams of the old name are left in place, FindByName checks the current name anyway.
+	if (previous)
+	{
+		char previousBuffer[ITEM_NAME_LEN];
+		if (GetLowerName(*GetDefinition(*previous), previousBuffer) == name)
+			return;
+	}
+
+	std::vector<uint32_t> trigrams;
+	for (size_t pos = 0; pos + 3 <= name.length(); ++pos)
+		trigrams.push_back(GetTrigram(name, pos));
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	for (uint32_t trigram : trigrams)
+		m_trigrams[trigram].push_back(record.itemNumber);
+}
+
+bool ItemCatalog::Observe(const ItemDefinition& definition, uint32_t itemHash)
+{
+	auto iter = m_items.find(definition.ItemNumber);
+	if (iter != m_items.end())
+	{
+		const Record& latest = *iter->second;
+
+		if (itemHash != 0 && latest.itemHash == itemHash)
+			return false;
+
+		if (memcmp(latest.definition, &definition, sizeof(ItemDefinition)) == 0)
+			return false;
+	}
+
+	auto record = std::make_unique<Record>();
+	record->itemNumber = definition.ItemNumber;
+	record->itemHash = itemHash;
+	record->observedTime = static_cast<int64_t>(std::time(nullptr));
+	memcpy(record->definition, &definition, sizeof(ItemDefinition));
+
+	if (m_fileHandle && !Append(*record))
+	{
+		// Keep cataloging in memory only. A partial snapshot is dropped by the next append or
+		// Open, from this client or another.
+		CloseHandle(m_fileHandle);
+		m_fileHandle = nullptr;
+	}
+
+	Index(*record);
+	m_appended.push_back(std::move(record));
+	return true;
+}
+
+bool ItemCatalog::Observe(const ItemClient& item)
+{
+	const ItemDefinition* definition = item.GetItemDefinition();
+	if (!definition)
+		return false;
+
+	return Observe(*definition, item.ItemHash);
+}
+
+int ItemCatalog::Observe(const ItemContainer& container)
+{
+	int numObserved = 0;
+
+	container.VisitItemRefs([&](ItemRef item, const ItemIndex&)
+		{
+			if (Observe(*item))
+				++numObserved;
+		});
+
+	return numObserved;
+}
+
+const ItemDefinition* ItemCatalog::Find(int itemNumber) const
+{
+	auto iter = m_items.find(itemNumber);
+	if (iter == m_items.end())
+		return nullptr;
+
+	return GetDefinition(*iter->second);
+}
+
+uint32_t ItemCatalog::GetItemHash(int itemNumber) const
+{
+	auto iter = m_items.find(itemNumber);
+	if (iter == m_items.end())
+		return 0;
+
+	return iter->second->itemHash;
+}
+
+int ItemCatalog::FindByName(std::string_view text, std::vector<const ItemDefinition*>& results, size_t maxResults) const
+{
+	std::string query(text);
+	std::transform(query.begin(), query.end(), query.begin(), ToLowerAscii);
+
+	auto matches = [&](const Record& record)
+	{
+		char nameBuffer[ITEM_NAME_LEN];
+		return GetLowerName(*GetDefinition(record), nameBuffer).find(query) != std::string_view::npos;
+	};
+
+	std::vector<int> candidates;
+
+	if (query.length() < 3)
+	{
+		// Too short to have a trigram, look at everything.
+		candidates.reserve(m_items.size());
+		for (const auto& [itemNumber, record] : m_items)
+			candidates.push_back(itemNumber);
+	}
+	else
+	{
+		// Every match contains every trigram of the query, so the rarest one has the fewest
+		// candidates to check.
+		const std::vector<int>* rarest = nullptr;
+		for (size_t pos = 0; pos + 3 <= query.length(); ++pos)
+		{
+			auto iter = m_trigrams.find(GetTrigram(query, pos));
+			if (iter == m_trigrams.end())
+				return 0;
+
+			if (!rarest || iter->second.size() < rarest->size())
+				rarest = &iter->second;
+		}
+
+		candidates = *rarest;
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+	int found = 0;
+	for (int itemNumber : candidates)
+	{
+		const Record& record = *m_items.at(itemNumber);
+		if (!matches(record))
+			continue;
+
+		results.push_back(GetDefinition(record));
+		++found;
+
+		if (maxResults != 0 && static_cast<size_t>(found) >= maxResults)
+			break;
+	}
+
+	return found;
+}
+
+} // namespace eqlib
@@ -0,0 +1,121 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Items.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+// A persistent catalog of item definitions, for looking up items that are no longer (or not yet)
+// loaded by the client.
+//
+// Every definition passed to Observe is appended to a file as a snapshot, unless the catalog
+// already has the same version of it. Versions are told apart by the item's ItemHash, or by the
+// definition's contents when there isn't one. The file is only ever appended to; on Open the
+// existing snapshots are memory mapped and the latest version of each item is indexed by item
+// number and by trigrams of its name.
+//
+// Snapshots are raw ItemDefinition records. If the size of ItemDefinition changes with a patch,
+// the old file can't be read and is started over.
+//
+// Several clients can share one catalog file. Opening it and appending to it are serialized
+// with a file lock, so their snapshots don't interleave. Snapshots appended by other clients
+// are in the file but only show up here after the catalog is opened again.
+//
+// Definitions handed out point into the mapping or into the catalog's own storage and stay
+// valid until Close.
+class ItemCatalog
+{
+public:
+	EQLIB_OBJECT ItemCatalog();
+	EQLIB_OBJECT ~ItemCatalog();
+
+	ItemCatalog(const ItemCatalog&) = delete;
+	ItemCatalog& operator=(const ItemCatalog&) = delete;
+
+	// Opens (or creates) the catalog at |path| and indexes its contents. Returns false if the
+	// file can't be opened for writing.
+	EQLIB_OBJECT bool Open(const std::string& path);
+	EQLIB_OBJECT void Close();
+
+	// False if the catalog was never opened, or if writing to it failed.
+	bool IsOpen() const { return m_fileHandle != nullptr; }
+
+	// Records a definition. Returns true if it was new, or a new version of an item.
+	EQLIB_OBJECT bool Observe(const ItemDefinition& definition, uint32_t itemHash = 0);
+	EQLIB_OBJECT bool Observe(const ItemClient& item);
+
+	// Records every item in |container|, including the contents of bags and augments. Returns
+	// the number of new definitions.
+	EQLIB_OBJECT int Observe(const ItemContainer& container);
+
+	// Returns the latest snapshot of an item, or nullptr.
+	EQLIB_OBJECT const ItemDefinition* Find(int itemNumber) const;
+
+	// Returns the ItemHash of the latest snapshot of an item, or 0.
+	EQLIB_OBJECT uint32_t GetItemHash(int itemNumber) const;
+
+	// Appends the items whose name contains |text| (case insensitive) to |results|, up to
+	// |maxResults| of them if it isn't 0. Returns the number appended.
+	EQLIB_OBJECT int FindByName(std::string_view text, std::vector<const ItemDefinition*>& results,
+		size_t maxResults = 0) const;
+
+	size_t GetItemCount() const { return m_items.size(); }
+	size_t GetSnapshotCount() const { return m_numMapped + m_appended.size(); }
+
+private:
+#pragma pack(push, 1)
+	struct Record
+	{
+		int32_t  itemNumber;
+		uint32_t itemHash;
+		int64_t  observedTime;
+		uint8_t  definition[sizeof(ItemDefinition)];
+	};
+#pragma pack(pop)
+
+	static const ItemDefinition* GetDefinition(const Record& record)
+	{
+		return reinterpret_cast<const ItemDefinition*>(record.definition);
+	}
+
+	bool Load();
+	bool Append(const Record& record);
+	bool Map(uint64_t numRecords);
+	void Unmap();
+	void Index(const Record& record);
+
+	std::string m_path;
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+	const void* m_view = nullptr;
+	const Record* m_mapped = nullptr;
+	size_t m_numMapped = 0;
+
+	// Snapshots taken since the file was opened. They are already in the file, but not in the
+	// mapping.
+	std::vector<std::unique_ptr<Record>> m_appended;
+
+	std::unordered_map<int, const Record*> m_items;                // latest snapshot by item number
+	std::unordered_map<uint32_t, std::vector<int>> m_trigrams;     // item numbers by name trigram
+};
+
+} // namespace eqlib
@@ -430,6 +430,19 @@ ItemPtr ItemContainer::GetItem(const ItemIndex& index) const
 	return ItemPtr();
 }
 
+ItemRef ItemContainer::GetItemRef(const ItemIndex& index) const
+{
+	ItemContainer* container = nullptr;
+	short slot = -1;
+
+	if (GetIndex(index, container, slot))
+	{
+		return container->GetItemRef(slot);
+	}
+
+	return nullptr;
+}
+
 ItemIndex ItemContainer::CreateItemIndex(int slot0, int slot1 /* = -1 */, int slot2 /* = -1 */) const
 {
 	ItemIndex itemIndex;
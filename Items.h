@@ -301,6 +301,12 @@ class ItemClient;
 
 using ItemPtr = eqstd::shared_ptr<ItemClient>;
 
+// A borrowed pointer to an item. It doesn't keep the item alive, so it is only good for as long
+// as the container holding the item is left alone, e.g. during a visit. Copy the ItemPtr to keep
+// an item around. Handing these out instead of ItemPtr avoids a reference count increment and
+// decrement for every item looked at.
+using ItemRef = ItemClient*;
+
 template <> struct has_implicit_shared_pointer_cast<ItemBase> : std::true_type {};
 template <> struct has_implicit_shared_pointer_cast<ItemClient> : std::true_type {};
 
@@ -410,6 +416,36 @@ private:
 	template <typename Visitor>
 	Visitor& VisitItemsImpl(int beginSlot, int endSlot, int depth, ItemIndex& cursor, Visitor& visitor) const;
 
+public:
+	//
+	// functions used for visiting items without taking a reference to them
+	//
+
+	// Visitor functions take the form of: void Visitor(ItemRef item, const ItemIndex& location)
+	// The items are borrowed from the container, and must not be kept past the visit.
+
+	// Visit a specified range and depth
+	template <typename Visitor>
+	Visitor VisitItemRefs(int beginSlot, int endSlot, int depth, Visitor visitor) const
+	{
+		VisitItems(beginSlot, endSlot, depth, [&visitor](const ItemPtr& item, const ItemIndex& location) { visitor(item.get(), location); });
+		return visitor;
+	}
+
+	// Visit to a specified depth
+	template <typename Visitor>
+	Visitor VisitItemRefs(int depth, Visitor visitor) const
+	{
+		return VisitItemRefs(-1, -1, depth, std::move(visitor));
+	}
+
+	// Visit Everything
+	template <typename Visitor>
+	Visitor VisitItemRefs(Visitor visitor) const
+	{
+		return VisitItemRefs(-1, -1, -1, std::move(visitor));
+	}
+
 public:
 	//
 	// functions for visiting containers and items (does not visit placed augments)
@@ -477,6 +513,44 @@ public:
 		return FindItemImpl(-1, -1, -1, cursor, visitor, searchAll);
 	}
 
+	// Like FindItem, but also returns the item that was found, borrowed from the container.
+	// Predicates take the same form as for FindItem. Returns nullptr if nothing matched.
+	template <typename Predicate>
+	ItemRef FindItemRef(int beginSlot, int endSlot, int depth, Predicate predicate, ItemIndex* outIndex = nullptr, bool searchAll = true) const
+	{
+		const ItemPtr* found = FindItemPtr(beginSlot, endSlot, depth, predicate, outIndex, searchAll);
+		return found ? found->get() : nullptr;
+	}
+
+	template <typename Predicate>
+	ItemRef FindItemRef(Predicate predicate, ItemIndex* outIndex = nullptr, bool searchAll = true) const
+	{
+		return FindItemRef(-1, -1, -1, std::move(predicate), outIndex, searchAll);
+	}
+
+	// Like FindItemRef, but returns the container's own ItemPtr so that a caller that wants to keep
+	// the item pays for a single copy.
+	template <typename Predicate>
+	const ItemPtr* FindItemPtr(int beginSlot, int endSlot, int depth, Predicate predicate, ItemIndex* outIndex = nullptr, bool searchAll = true) const
+	{
+		const ItemPtr* found = nullptr;
+
+		ItemIndex index = FindItem(beginSlot, endSlot, depth,
+			[&](const ItemPtr& item, const ItemIndex& location)
+			{
+				if (!predicate(item, location))
+					return false;
+
+				found = &item;
+				return true;
+			}, searchAll);
+
+		if (outIndex)
+			*outIndex = index;
+
+		return found;
+	}
+
 private:
 	template <typename Predicate>
 	ItemIndex FindItemImpl(int beginSlot, int endSlot, int depth, ItemIndex& cursor, Predicate& predicate, bool searchAll = true) const;
@@ -525,6 +599,17 @@ public:
 	// Retrieve an item with its item index
 	EQLIB_OBJECT ItemPtr GetItem(const ItemIndex& index) const;
 
+	// Same as GetItem, but borrows the item instead of taking a reference to it.
+	ItemRef GetItemRef(int index) const
+	{
+		if (index >= 0 && index < (int)m_items.size() && index < (int)m_size)
+			return m_items[index].get();
+
+		return nullptr;
+	}
+
+	EQLIB_OBJECT ItemRef GetItemRef(const ItemIndex& index) const;
+
 	// A visitor to count the number of items.
 	struct ItemCountVisitor
 	{
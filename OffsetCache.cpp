@@ -0,0 +1,384 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "OffsetCache.h"
+
+#include "Common.h"
+#include "OffsetUtils.h"
+
+namespace eqlib {
+
+static constexpr uint32_t OFFSET_CACHE_MAGIC = 0x43464F45; // 'EOFC'
+static constexpr uint32_t OFFSET_CACHE_VERSION = 1;
+
+// Number of cached signatures that are always verified in OffsetCacheVerify::Sample mode, and
+// the interval between verified signatures after that.
+static constexpr uint32_t OFFSET_CACHE_SAMPLE_FIRST = 8;
+static constexpr uint32_t OFFSET_CACHE_SAMPLE_INTERVAL = 16;
+
+#pragma pack(push, 1)
+struct OffsetCacheHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t imageHash;
+	uint32_t pointerSize;
+	uint32_t numEntries;
+};
+#pragma pack(pop)
+
+static uint64_t HashBytes(const uint8_t* data, size_t length, uint64_t hash = 14695981039346656037ull)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+static uint64_t HashName(std::string_view name)
+{
+	return HashBytes(reinterpret_cast<const uint8_t*>(name.data()), name.length());
+}
+
+uint64_t GetModuleImageHash(uintptr_t moduleBase)
+{
+	if (!moduleBase)
+		return 0;
+
+	auto dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(moduleBase);
+	if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE)
+		return 0;
+
+	auto ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(moduleBase + dosHeader->e_lfanew);
+	if (ntHeaders->Signature != IMAGE_NT_SIGNATURE)
+		return 0;
+
+	// The headers are never written to after the loader is done with them, so unlike the code
+	// sections they aren't affected by detours that are already in place.
+	uint32_t sizeOfHeaders = ntHeaders->OptionalHeader.SizeOfHeaders;
+	uint32_t sizeOfImage = ntHeaders->OptionalHeader.SizeOfImage;
+
+	// ImageBase is rewritten with the actual base when the image is relocated, so hash the
+	// headers with it left out.
+	const uint8_t* headers = reinterpret_cast<const uint8_t*>(moduleBase);
+	size_t imageBaseOffset = reinterpret_cast<const uint8_t*>(&ntHeaders->OptionalHeader.ImageBase) - headers;
+
+	uint64_t hash = HashBytes(headers, imageBaseOffset);
+	hash = HashBytes(headers + imageBaseOffset + sizeof(ntHeaders->OptionalHeader.ImageBase),
+		sizeOfHeaders - imageBaseOffset - sizeof(ntHeaders->OptionalHeader.ImageBase), hash);
+	hash = HashBytes(reinterpret_cast<const uint8_t*>(&sizeOfImage), sizeof(sizeOfImage), hash);
+
+	// Never hand out 0, it's used to mean "no image".
+	return hash ? hash : 1;
+}
+
+//============================================================================
+// OffsetCache
+//============================================================================
+
+OffsetCache::OffsetCache()
+{
+}
+
+OffsetCache::~OffsetCache()
+{
+	Close();
+}
+
+bool OffsetCache::Open(const std::string& path, uintptr_t moduleBase)
+{
+	Close();
+
+	m_path = path;
+	m_moduleBase = moduleBase;
+	m_imageHash = GetModuleImageHash(moduleBase);
+
+	if (!m_imageHash)
+		return false;
+
+	return Map();
+}
+
+void OffsetCache::Close()
+{
+	Unmap();
+
+	m_added.clear();
+	m_cachedLookups = 0;
+	m_dirty = false;
+	m_hits = 0;
+	m_misses = 0;
+}
+
+bool OffsetCache::Map()
+{
+	HANDLE hFile = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(OffsetCacheHeader)))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_fileHandle = hFile;
+	m_mappingHandle = hMapping;
+
+	auto header = static_cast<const OffsetCacheHeader*>(view);
+	size_t expectedSize = sizeof(OffsetCacheHeader) + static_cast<size_t>(header->numEntries) * sizeof(Entry);
+
+	if (header->magic != OFFSET_CACHE_MAGIC
+		|| header->version != OFFSET_CACHE_VERSION
+		|| header->imageHash != m_imageHash
+		|| header->pointerSize != sizeof(uintptr_t)
+		|| static_cast<size_t>(fileSize.QuadPart) != expectedSize)
+	{
+		// Built from a different image (or not one of ours). Keep going with an empty cache,
+		// the next Save will replace it.
+		m_mapped = reinterpret_cast<const Entry*>(header + 1);
+		Unmap();
+		return false;
+	}
+
+	m_mapped = reinterpret_cast<const Entry*>(header + 1);
+	m_numMapped = header->numEntries;
+	return true;
+}
+
+void OffsetCache::Unmap()
+{
+	if (m_mapped)
+	{
+		UnmapViewOfFile(reinterpret_cast<const OffsetCacheHeader*>(m_mapped) - 1);
+		m_mapped = nullptr;
+	}
+
+	m_numMapped = 0;
+
+	if (m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = nullptr;
+	}
+}
+
+void OffsetCache::Discard()
+{
+	if (m_numMapped == 0)
+		return;
+
+	// Anything resolved since the file was loaded is still good, but nothing else can be
+	// trusted. Saving will rewrite the file without the stale entries.
+	Unmap();
+	m_dirty = true;
+}
+
+const OffsetCache::Entry* OffsetCache::FindEntry(uint64_t nameHash) const
+{
+	// Entries resolved during this session take priority over the ones that were loaded.
+	for (const Entry& entry : m_added)
+	{
+		if (entry.nameHash == nameHash)
+			return &entry;
+	}
+
+	const Entry* first = m_mapped;
+	const Entry* last = m_mapped + m_numMapped;
+
+	auto iter = std::lower_bound(first, last, nameHash,
+		[](const Entry& entry, uint64_t hash) { return entry.nameHash < hash; });
+
+	if (iter != last && iter->nameHash == nameHash)
+		return iter;
+
+	return nullptr;
+}
+
+uintptr_t OffsetCache::Lookup(std::string_view name) const
+{
+	if (const Entry* entry = FindEntry(HashName(name)))
+		return m_moduleBase + entry->rva;
+
+	return 0;
+}
+
+void OffsetCache::Store(std::string_view name, uintptr_t address)
+{
+	if (!m_moduleBase || address < m_moduleBase || address - m_moduleBase > UINT32_MAX)
+		return;
+
+	uint64_t nameHash = HashName(name);
+	uint32_t rva = static_cast<uint32_t>(address - m_moduleBase);
+
+	if (const Entry* entry = FindEntry(nameHash))
+	{
+		if (entry->rva == rva)
+			return;
+
+		if (entry >= m_added.data() && entry < m_added.data() + m_added.size())
+		{
+			const_cast<Entry*>(entry)->rva = rva;
+			m_dirty = true;
+			return;
+		}
+	}
+
+	m_added.push_back(Entry{ nameHash, rva, 0 });
+	m_dirty = true;
+}
+
+bool OffsetCache::ShouldVerify()
+{
+	switch (m_verifyMode)
+	{
+	case OffsetCacheVerify::All:
+		return true;
+
+	case OffsetCacheVerify::Sample: {
+		uint32_t lookup = m_cachedLookups++;
+		return lookup < OFFSET_CACHE_SAMPLE_FIRST
+			|| (lookup - OFFSET_CACHE_SAMPLE_FIRST) % OFFSET_CACHE_SAMPLE_INTERVAL == 0;
+	}
+
+	case OffsetCacheVerify::None:
+	default:
+		return false;
+	}
+}
+
+uintptr_t OffsetCache::FindPattern(std::string_view name, uintptr_t dwAddress, uintptr_t dwLen,
+	const uint8_t* bPattern, const char* szMask)
+{
+	if (uintptr_t cached = Lookup(name))
+	{
+		if (cached >= dwAddress && cached - dwAddress < dwLen)
+		{
+			if (!ShouldVerify() || DataCompare(reinterpret_cast<const uint8_t*>(cached), bPattern, szMask))
+			{
+				++m_hits;
+				return cached;
+			}
+		}
+
+		// A cached signature didn't match. The image hash should have prevented this, so don't
+		// trust anything else that came from the same file.
+		Discard();
+	}
+
+	++m_misses;
+
+	uintptr_t address = eqlib::FindPattern(dwAddress, dwLen, bPattern, szMask);
+	if (address)
+	{
+		Store(name, address);
+	}
+
+	return address;
+}
+
+bool OffsetCache::Save()
+{
+	if (!m_dirty || !m_imageHash || m_path.empty())
+		return false;
+
+	// Merge what was loaded with what was resolved since, letting the new entries win.
+	std::vector<Entry> entries(m_added);
+	std::sort(entries.begin(), entries.end(),
+		[](const Entry& a, const Entry& b) { return a.nameHash < b.nameHash; });
+
+	for (size_t i = 0; i < m_numMapped; ++i)
+	{
+		if (!std::binary_search(entries.begin(), entries.begin() + m_added.size(), m_mapped[i],
+			[](const Entry& a, const Entry& b) { return a.nameHash < b.nameHash; }))
+		{
+			entries.push_back(m_mapped[i]);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const Entry& a, const Entry& b) { return a.nameHash < b.nameHash; });
+
+	OffsetCacheHeader header;
+	header.magic = OFFSET_CACHE_MAGIC;
+	header.version = OFFSET_CACHE_VERSION;
+	header.imageHash = m_imageHash;
+	header.pointerSize = sizeof(uintptr_t);
+	header.numEntries = static_cast<uint32_t>(entries.size());
+
+	// The file can't be replaced while it's mapped. Write the new one next to it first so that
+	// a failure part way through doesn't leave a truncated cache behind.
+	Unmap();
+
+	std::string tempPath = m_path + ".tmp";
+	HANDLE hFile = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	DWORD written = 0;
+	DWORD entriesSize = static_cast<DWORD>(entries.size() * sizeof(Entry));
+	bool success = WriteFile(hFile, &header, sizeof(header), &written, nullptr) && written == sizeof(header)
+		&& (entriesSize == 0 || (WriteFile(hFile, entries.data(), entriesSize, &written, nullptr) && written == entriesSize));
+	CloseHandle(hFile);
+
+	if (!success || !MoveFileExA(tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFileA(tempPath.c_str());
+
+		// Keep serving what we have in memory.
+		m_added = std::move(entries);
+		return false;
+	}
+
+	m_added.clear();
+	m_dirty = false;
+	m_cachedLookups = 0;
+
+	if (!Map())
+	{
+		m_added = std::move(entries);
+	}
+
+	return true;
+}
+
+} // namespace eqlib
@@ -0,0 +1,133 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Config.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace eqlib {
+
+// Returns a hash that identifies a loaded module image. This covers the PE headers (which carry
+// the link timestamp, checksum, and every section's size and location) and the image size, so
+// it changes with every patch but is cheap enough to compute at startup.
+EQLIB_OBJECT uint64_t GetModuleImageHash(uintptr_t moduleBase);
+
+enum class OffsetCacheVerify
+{
+	// Trust cached entries.
+	None,
+
+	// Verify the first few cached signatures that are looked up, and one in every few after
+	// that. If one of them fails, everything that was loaded from disk is discarded.
+	Sample,
+
+	// Verify every cached signature against the image when it is looked up.
+	All,
+};
+
+// Persistent cache of offsets that were resolved at runtime, such as addresses found by
+// FindPattern or read out of an instruction with GetDWordAt/GetFunctionAddressAt.
+//
+// Entries are stored as RVAs relative to the module base, keyed by name, in a file that is
+// memory mapped on load. The file records the hash of the module image it was built from
+// (see GetModuleImageHash), and is ignored if the image doesn't match, so after a patch the
+// first start resolves everything from scratch and saves a fresh cache.
+//
+// Typical use:
+//
+//     OffsetCache cache;
+//     cache.Open(path, EQGameBaseAddress);
+//     uintptr_t addr = cache.FindPattern("CDisplay__Foo", start, len, pattern, mask);
+//     ...
+//     cache.Save();
+class OffsetCache
+{
+public:
+	EQLIB_OBJECT OffsetCache();
+	EQLIB_OBJECT ~OffsetCache();
+
+	OffsetCache(const OffsetCache&) = delete;
+	OffsetCache& operator=(const OffsetCache&) = delete;
+
+	// Maps the cache file at |path| for the module loaded at |moduleBase|. Returns true if the
+	// file existed and was built from the same image. On false the cache starts out empty and
+	// Save will write a new file to |path|.
+	EQLIB_OBJECT bool Open(const std::string& path, uintptr_t moduleBase);
+	EQLIB_OBJECT void Close();
+
+	void SetVerifyMode(OffsetCacheVerify mode) { m_verifyMode = mode; }
+	OffsetCacheVerify GetVerifyMode() const { return m_verifyMode; }
+
+	// True if entries were loaded from disk and have not been discarded.
+	bool IsWarm() const { return m_numMapped != 0; }
+	size_t GetEntryCount() const { return m_numMapped + m_added.size(); }
+
+	// Returns the cached address for |name|, or 0 if there isn't one.
+	EQLIB_OBJECT uintptr_t Lookup(std::string_view name) const;
+
+	// Records the address for |name|. Addresses outside of the module are ignored.
+	EQLIB_OBJECT void Store(std::string_view name, uintptr_t address);
+
+	// Returns the cached address for |name| if there is one and it still matches the pattern
+	// (subject to the verify mode), otherwise scans [dwAddress, dwAddress + dwLen) with
+	// FindPattern and caches the result.
+	EQLIB_OBJECT uintptr_t FindPattern(std::string_view name, uintptr_t dwAddress, uintptr_t dwLen,
+		const uint8_t* bPattern, const char* szMask);
+
+	// Writes the cache back to the path it was opened with, if anything changed.
+	EQLIB_OBJECT bool Save();
+
+	// Number of lookups that were served from the cache and that had to be resolved.
+	uint32_t GetHitCount() const { return m_hits; }
+	uint32_t GetMissCount() const { return m_misses; }
+
+private:
+#pragma pack(push, 1)
+	struct Entry
+	{
+		uint64_t nameHash;
+		uint32_t rva;
+		uint32_t reserved;
+	};
+#pragma pack(pop)
+
+	const Entry* FindEntry(uint64_t nameHash) const;
+	bool ShouldVerify();
+	bool Map();
+	void Unmap();
+	void Discard();
+
+	std::string m_path;
+	uintptr_t m_moduleBase = 0;
+	uint64_t m_imageHash = 0;
+	OffsetCacheVerify m_verifyMode = OffsetCacheVerify::Sample;
+
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+	const Entry* m_mapped = nullptr;   // sorted by nameHash
+	size_t m_numMapped = 0;
+
+	std::vector<Entry> m_added;        // entries resolved since the file was loaded
+	uint32_t m_cachedLookups = 0;
+	bool m_dirty = false;
+	uint32_t m_hits = 0;
+	uint32_t m_misses = 0;
+};
+
+} // namespace eqlib
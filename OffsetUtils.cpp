@@ -0,0 +1,245 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "OffsetUtils.h"
+
+#include <emmintrin.h>
+#include <intrin.h>
+
+namespace eqlib {
+
+// Bytes that show up constantly in x86/x64 code and padding. Anchoring a single pattern on these
+// produces too many candidates, so they are avoided when picking an anchor without a histogram.
+static bool IsCommonCodeByte(uint8_t b)
+{
+	switch (b)
+	{
+	case 0x00: case 0x01: case 0x0F: case 0x24: case 0x44: case 0x48: case 0x4C: case 0x74:
+	case 0x75: case 0x83: case 0x85: case 0x89: case 0x8B: case 0x8D: case 0x90: case 0xC0:
+	case 0xC3: case 0xCC: case 0xE8: case 0xFF:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+// A pair of adjacent unmasked bytes in a pattern, at |offset| from the start of the pattern.
+struct PatternAnchor
+{
+	size_t offset = 0;
+	size_t maskLength = 0;
+	bool valid = false;
+};
+
+template <typename ScoreFn>
+static PatternAnchor FindPatternAnchor(const uint8_t* bPattern, const char* szMask, ScoreFn&& score)
+{
+	PatternAnchor anchor;
+	uint32_t bestScore = UINT32_MAX;
+
+	size_t length = 0;
+	for (; szMask[length]; ++length)
+	{
+		if (length > 0 && szMask[length - 1] == 'x' && szMask[length] == 'x')
+		{
+			uint32_t pairScore = score(bPattern[length - 1], bPattern[length]);
+			if (!anchor.valid || pairScore < bestScore)
+			{
+				anchor.offset = length - 1;
+				anchor.valid = true;
+				bestScore = pairScore;
+			}
+		}
+	}
+
+	anchor.maskLength = length;
+	return anchor;
+}
+
+static uintptr_t FindPatternScalar(uintptr_t dwAddress, uintptr_t dwLen, const uint8_t* bPattern, const char* szMask)
+{
+	for (uintptr_t i = 0; i < dwLen; i++)
+	{
+		if (DataCompare(reinterpret_cast<uint8_t*>(dwAddress + i), bPattern, szMask))
+			return dwAddress + i;
+	}
+
+	return 0;
+}
+
+uintptr_t FindPattern(uintptr_t dwAddress, uintptr_t dwLen, const uint8_t* bPattern, const char* szMask)
+{
+	PatternAnchor anchor = FindPatternAnchor(bPattern, szMask,
+		[](uint8_t a, uint8_t b) { return (IsCommonCodeByte(a) ? 1u : 0u) + (IsCommonCodeByte(b) ? 1u : 0u); });
+
+	if (!anchor.valid)
+		return FindPatternScalar(dwAddress, dwLen, bPattern, szMask);
+
+	const uint8_t* base = reinterpret_cast<const uint8_t*>(dwAddress);
+	const __m128i first = _mm_set1_epi8(static_cast<char>(bPattern[anchor.offset]));
+	const __m128i second = _mm_set1_epi8(static_cast<char>(bPattern[anchor.offset + 1]));
+
+	// The loads never reach past the last byte that the scalar comparison would have read
+	// for the last position in the range, because the anchor ends before the mask does.
+	uintptr_t i = 0;
+	for (; i + 16 <= dwLen; i += 16)
+	{
+		const uint8_t* p = base + i + anchor.offset;
+
+		__m128i matchFirst = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), first);
+		__m128i matchSecond = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)), second);
+		unsigned int candidates = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(matchFirst, matchSecond)));
+
+		while (candidates)
+		{
+			unsigned long bit;
+			_BitScanForward(&bit, candidates);
+			candidates &= candidates - 1;
+
+			if (DataCompare(base + i + bit, bPattern, szMask))
+				return dwAddress + i + bit;
+		}
+	}
+
+	for (; i < dwLen; ++i)
+	{
+		if (DataCompare(base + i, bPattern, szMask))
+			return dwAddress + i;
+	}
+
+	return 0;
+}
+
+size_t FindPatterns(uintptr_t dwAddress, uintptr_t dwLen, const SignaturePattern* patterns,
+	size_t numPatterns, uintptr_t* outResults)
+{
+	if (numPatterns == 0)
+		return 0;
+
+	std::fill(outResults, outResults + numPatterns, 0);
+
+	if (dwLen < 2)
+	{
+		size_t found = 0;
+		for (size_t index = 0; index < numPatterns; ++index)
+		{
+			outResults[index] = FindPatternScalar(dwAddress, dwLen, patterns[index].pattern, patterns[index].mask);
+			found += outResults[index] != 0;
+		}
+
+		return found;
+	}
+
+	const uint8_t* base = reinterpret_cast<const uint8_t*>(dwAddress);
+
+	// Histogram of every adjacent byte pair in the image, used to pick the rarest anchor for
+	// each pattern. One linear pass, shared by all of the patterns.
+	std::vector<uint32_t> pairCounts(65536, 0);
+	for (uintptr_t i = 0; i + 1 < dwLen; ++i)
+	{
+		++pairCounts[base[i] | (base[i + 1] << 8)];
+	}
+
+	struct AnchoredPattern
+	{
+		size_t index;
+		size_t offset;
+	};
+
+	std::vector<AnchoredPattern> anchored;
+	anchored.reserve(numPatterns);
+
+	std::vector<uint32_t> bucketStart(65536 + 1, 0);
+	std::vector<uint16_t> anchorPair(numPatterns, 0);
+	size_t maxOffset = 0;
+	size_t found = 0;
+
+	for (size_t index = 0; index < numPatterns; ++index)
+	{
+		const SignaturePattern& signature = patterns[index];
+
+		PatternAnchor anchor = FindPatternAnchor(signature.pattern, signature.mask,
+			[&](uint8_t a, uint8_t b) { return pairCounts[a | (b << 8)]; });
+
+		if (!anchor.valid)
+		{
+			// Nothing to anchor on (e.g. every other byte is masked). These are rare enough to
+			// just scan for individually.
+			outResults[index] = FindPatternScalar(dwAddress, dwLen, signature.pattern, signature.mask);
+			found += outResults[index] != 0;
+			continue;
+		}
+
+		uint16_t pair = static_cast<uint16_t>(signature.pattern[anchor.offset] | (signature.pattern[anchor.offset + 1] << 8));
+		anchorPair[index] = pair;
+		anchored.push_back(AnchoredPattern{ index, anchor.offset });
+		++bucketStart[pair + 1];
+
+		maxOffset = std::max(maxOffset, anchor.offset);
+	}
+
+	if (anchored.empty())
+		return found;
+
+	// Bucket the patterns by anchor pair so that each position in the image only has to look
+	// at the patterns that are anchored on the pair found there.
+	for (size_t pair = 0; pair < 65536; ++pair)
+		bucketStart[pair + 1] += bucketStart[pair];
+
+	std::vector<AnchoredPattern> buckets(anchored.size());
+	{
+		std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+		for (const AnchoredPattern& entry : anchored)
+			buckets[fill[anchorPair[entry.index]]++] = entry;
+	}
+
+	size_t remaining = anchored.size();
+
+	// Every pair position that could belong to a match starting in [0, dwLen). As with
+	// FindPattern, patterns starting near the end may be compared past the end of the range.
+	const uintptr_t scanEnd = dwLen - 1 + maxOffset;
+	for (uintptr_t pos = 0; pos < scanEnd && remaining > 0; ++pos)
+	{
+		uint16_t pair = static_cast<uint16_t>(base[pos] | (base[pos + 1] << 8));
+
+		uint32_t first = bucketStart[pair];
+		uint32_t last = bucketStart[pair + 1];
+
+		for (uint32_t entry = first; entry < last; ++entry)
+		{
+			const AnchoredPattern& candidate = buckets[entry];
+
+			if (outResults[candidate.index] != 0 || pos < candidate.offset)
+				continue;
+
+			uintptr_t start = pos - candidate.offset;
+			if (start >= dwLen)
+				continue;
+
+			const SignaturePattern& signature = patterns[candidate.index];
+			if (DataCompare(base + start, signature.pattern, signature.mask))
+			{
+				outResults[candidate.index] = dwAddress + start;
+				++found;
+				--remaining;
+			}
+		}
+	}
+
+	return found;
+}
+
+} // namespace eqlib
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include "Config.h"
+
+#include <cstddef>
 #include <cstdint>
 
 namespace eqlib {
@@ -31,16 +34,26 @@ inline bool DataCompare(const uint8_t* pData, const uint8_t* bMask, const char*
 	return (*szMask) == 0;
 }
 
-inline uintptr_t FindPattern(uintptr_t dwAddress, uintptr_t dwLen, const uint8_t* bPattern, const char* szMask)
+// Returns the address of the first match of |bPattern| in [dwAddress, dwAddress + dwLen). Only
+// bytes whose |szMask| character is 'x' are compared. Candidates are found by checking one rare
+// pair of pattern bytes 16 positions at a time before comparing the whole pattern.
+EQLIB_OBJECT uintptr_t FindPattern(uintptr_t dwAddress, uintptr_t dwLen, const uint8_t* bPattern, const char* szMask);
+
+// A signature to be resolved by FindPatterns.
+struct SignaturePattern
 {
-	for (uintptr_t i = 0; i < dwLen; i++)
-	{
-		if (DataCompare(reinterpret_cast<uint8_t*>(dwAddress + i), bPattern, szMask))
-			return dwAddress + i;
-	}
+	const uint8_t* pattern;
+	const char*    mask;
+};
 
-	return 0;
-}
+// Resolves many signatures with a single pass over [dwAddress, dwAddress + dwLen). Each
+// signature is anchored on the pair of unmasked bytes that occurs least often in the image, and
+// the scan only compares the full pattern at positions where an anchor pair occurs.
+//
+// |outResults| receives, for each signature, the same address that FindPattern would return
+// for it, or 0 if there is no match. Returns the number of signatures that were found.
+EQLIB_OBJECT size_t FindPatterns(uintptr_t dwAddress, uintptr_t dwLen, const SignaturePattern* patterns,
+	size_t numPatterns, uintptr_t* outResults);
 
 inline uintptr_t GetDWordAt(uintptr_t address, uintptr_t numBytes)
 {
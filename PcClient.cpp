@@ -349,14 +349,18 @@ int CharacterZoneClient::GetFocusRangeModifier(const EQ_Spell* pSpell, ItemPtr&
 // TODO: Handle new range checks
 ItemPtr PcZoneClient::GetItemByItemClass(int itemClass, ItemIndex* index)
 {
-	ItemIndex itemIndex = GetItemPossessions().FindItem(
-		[&](const ItemPtr& item, const ItemIndex& index) { return item->GetItemClass() == itemClass; });
-	if (itemIndex.IsValid() && index)
-	{
+	// Keep the item that was found, rather than looking it up again by its index.
+	ItemIndex itemIndex;
+	const ItemPtr* found = GetItemPossessions().FindItemPtr(-1, -1, -1,
+		[&](const ItemPtr& item, const ItemIndex&) { return item->GetItemClass() == itemClass; }, &itemIndex);
+
+	if (!found)
+		return ItemPtr();
+
+	if (index)
 		*index = itemIndex;
-		return GetItemPossession(itemIndex);
-	}
-	return ItemPtr();
+
+	return *found;
 }
 
 //----------------------------------------------------------------------------
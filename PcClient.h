@@ -1070,13 +1070,16 @@ public:
 
 	int GetEffectSlot(EQ_Affect* effect)
 	{
-		for (int nBuffSlot = 0; nBuffSlot < MAX_TOTAL_BUFFS; ++nBuffSlot)
-		{
-			if (effect == &GetEffect(nBuffSlot))
-				return nBuffSlot;
-		}
+		// Effects are stored contiguously, so the slot falls out of the pointer.
+		int numSlots = std::min(GetMaxEffects(), MAX_TOTAL_BUFFS);
+		if (numSlots <= 0)
+			return -1;
 
-		return -1;
+		const EQ_Affect* first = &GetEffect(0);
+		if (effect < first || effect >= first + numSlots)
+			return -1;
+
+		return static_cast<int>(effect - first);
 	}
 
 	// Unverified
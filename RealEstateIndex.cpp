@@ -0,0 +1,300 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "RealEstateIndex.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace eqlib {
+
+static void HashValue(uint64_t& hash, uint64_t value)
+{
+	hash ^= value;
+	hash *= 0x100000001b3ull;
+}
+
+static uint32_t FloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+RealEstateItemIndex::RealEstateItemIndex(float cellSize)
+{
+	SetCellSize(cellSize);
+}
+
+void RealEstateItemIndex::Clear()
+{
+	m_lists.clear();
+	m_entries.clear();
+	m_byOwner.clear();
+	m_byCell.clear();
+	m_lastRescans = 0;
+}
+
+void RealEstateItemIndex::SetCellSize(float cellSize)
+{
+	m_cellSize = std::max(cellSize, 1.0f);
+	m_inverseCellSize = 1.0f / m_cellSize;
+
+	// The cell keys are baked into the index, so everything has to be collected again.
+	Clear();
+}
+
+uint64_t RealEstateItemIndex::GetCellKey(float x, float y) const
+{
+	int32_t cellX = static_cast<int32_t>(std::floor(x * m_inverseCellSize));
+	int32_t cellY = static_cast<int32_t>(std::floor(y * m_inverseCellSize));
+
+	return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
+
+uint64_t RealEstateItemIndex::GetFingerprint(const RealEstateItems& items)
+{
+	// The ids and addresses of the items, read from the list's hash table without touching the
+	// items themselves: adding, removing or replacing items shows up here, moving them doesn't.
+	uint64_t hash = 0xcbf29ce484222325ull;
+	HashValue(hash, reinterpret_cast<uintptr_t>(&items));
+	HashValue(hash, items.GetNumItems());
+
+	for (auto entry = items.realEstateItems.WalkFirstEntry(); entry; entry = items.realEstateItems.WalkNextEntry(entry))
+	{
+		HashValue(hash, static_cast<uint32_t>(entry->key()));
+		HashValue(hash, reinterpret_cast<uintptr_t>(entry->value()));
+	}
+
+	return hash;
+}
+
+void RealEstateItemIndex::HashItem(uint64_t& hash, const RealEstateItem* item)
+{
+	// Everything the index keeps about an item, so a moved, placed or picked up item shows up.
+	HashValue(hash, reinterpret_cast<uintptr_t>(item));
+	HashValue(hash, (static_cast<uint64_t>(static_cast<uint32_t>(item->GetRealEstateItemId())) << 32)
+		| static_cast<uint32_t>(item->GetOwnerNameHashKey()));
+	HashValue(hash, (static_cast<uint64_t>(FloatBits(item->GetX())) << 32) | FloatBits(item->GetY()));
+	HashValue(hash, (static_cast<uint64_t>(FloatBits(item->GetZ())) << 32) | (item->IsPlaced() ? 1 : 0));
+}
+
+uint64_t RealEstateItemIndex::GetContentFingerprint(const RealEstateItems& items)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	for (auto entry = items.realEstateItems.WalkFirstEntry(); entry; entry = items.realEstateItems.WalkNextEntry(entry))
+	{
+		if (const RealEstateItem* item = entry->value())
+			HashItem(hash, item);
+	}
+
+	return hash;
+}
+
+void RealEstateItemIndex::Invalidate(int realEstateId)
+{
+	for (auto& [id, record] : m_lists)
+	{
+		if (realEstateId == -1 || id == realEstateId)
+			record.invalidated = true;
+	}
+}
+
+bool RealEstateItemIndex::Update(const RealEstateManager& manager, bool checkItems)
+{
+	bool changed = false;
+	m_lastRescans = 0;
+
+	for (auto& [id, record] : m_lists)
+		record.seen = false;
+
+	for (auto list = manager.itemLists.WalkFirstEntry(); list; list = manager.itemLists.WalkNextEntry(list))
+	{
+		const RealEstateItems* items = list->value();
+		if (!items)
+			continue;
+
+		ListRecord& record = m_lists[items->GetId()];
+		record.seen = true;
+
+		uint64_t fingerprint = GetFingerprint(*items);
+		if (record.items == items && record.fingerprint == fingerprint && !record.invalidated
+			&& (!checkItems || record.contentFingerprint == GetContentFingerprint(*items)))
+		{
+			continue;
+		}
+
+		record.items = items;
+		record.fingerprint = fingerprint;
+		record.invalidated = false;
+		record.entries.clear();
+		record.entries.reserve(items->GetNumItems());
+
+		uint64_t contentFingerprint = 0xcbf29ce484222325ull;
+		for (auto entry = items->realEstateItems.WalkFirstEntry(); entry; entry = items->realEstateItems.WalkNextEntry(entry))
+		{
+			const RealEstateItem* item = entry->value();
+			if (!item)
+				continue;
+
+			HashItem(contentFingerprint, item);
+			record.entries.push_back(Entry{ item, item->GetPos(), items->GetId(), item->GetOwnerNameHashKey(),
+				std::string(item->GetOwnerName()), item->IsPlaced() });
+		}
+		record.contentFingerprint = contentFingerprint;
+
+		++m_lastRescans;
+		changed = true;
+	}
+
+	for (auto iter = m_lists.begin(); iter != m_lists.end();)
+	{
+		if (!iter->second.seen)
+		{
+			iter = m_lists.erase(iter);
+			changed = true;
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	if (changed)
+		Rebuild();
+
+	return changed;
+}
+
+void RealEstateItemIndex::Rebuild()
+{
+	m_entries.clear();
+	m_byOwner.clear();
+	m_byCell.clear();
+
+	for (const auto& [id, record] : m_lists)
+		m_entries.insert(m_entries.end(), record.entries.begin(), record.entries.end());
+
+	m_byOwner.reserve(m_entries.size());
+	m_byCell.reserve(m_entries.size());
+
+	for (int i = 0; i < static_cast<int>(m_entries.size()); ++i)
+	{
+		const Entry& entry = m_entries[i];
+
+		m_byOwner.emplace_back(entry.ownerNameHashKey, i);
+
+		if (entry.placed)
+			m_byCell.emplace_back(GetCellKey(entry.pos.X, entry.pos.Y), i);
+	}
+
+	std::sort(m_byOwner.begin(), m_byOwner.end());
+	std::sort(m_byCell.begin(), m_byCell.end());
+}
+
+int RealEstateItemIndex::FindItemsInRadius(const CVector3& center, float radius, std::vector<const RealEstateItem*>& items,
+	int realEstateId) const
+{
+	if (radius < 0.0f || m_byCell.empty())
+		return 0;
+
+	int32_t minX = static_cast<int32_t>(std::floor((center.X - radius) * m_inverseCellSize));
+	int32_t maxX = static_cast<int32_t>(std::floor((center.X + radius) * m_inverseCellSize));
+	int32_t minY = static_cast<int32_t>(std::floor((center.Y - radius) * m_inverseCellSize));
+	int32_t maxY = static_cast<int32_t>(std::floor((center.Y + radius) * m_inverseCellSize));
+
+	float radiusSquared = radius * radius;
+	int found = 0;
+
+	for (int32_t cellX = minX; cellX <= maxX; ++cellX)
+	{
+		// Cells sort by X then Y, so a column of cells is one contiguous range.
+		uint64_t first = (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(minY);
+		uint64_t last = (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(maxY);
+
+		// Negative Y cells sort after positive ones, so a column crossing Y = 0 is two ranges.
+		uint64_t ranges[2][2] = { { first, last }, { 0, 0 } };
+		int numRanges = 1;
+
+		if (minY < 0 && maxY >= 0)
+		{
+			ranges[0][0] = static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32;
+			ranges[0][1] = last;
+			ranges[1][0] = first;
+			ranges[1][1] = (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | 0xffffffffu;
+			numRanges = 2;
+		}
+
+		for (int range = 0; range < numRanges; ++range)
+		{
+			auto iter = std::lower_bound(m_byCell.begin(), m_byCell.end(), std::make_pair(ranges[range][0], INT_MIN));
+
+			for (; iter != m_byCell.end() && iter->first <= ranges[range][1]; ++iter)
+			{
+				const Entry& entry = m_entries[iter->second];
+
+				if (realEstateId != -1 && entry.realEstateId != realEstateId)
+					continue;
+
+				float dx = entry.pos.X - center.X;
+				float dy = entry.pos.Y - center.Y;
+				float dz = entry.pos.Z - center.Z;
+
+				if (dx * dx + dy * dy + dz * dz <= radiusSquared)
+				{
+					items.push_back(entry.item);
+					++found;
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+int RealEstateItemIndex::FindItemsByOwner(int ownerNameHashKey, std::vector<const RealEstateItem*>& items) const
+{
+	auto iter = std::lower_bound(m_byOwner.begin(), m_byOwner.end(), std::make_pair(ownerNameHashKey, INT_MIN));
+
+	int found = 0;
+	for (; iter != m_byOwner.end() && iter->first == ownerNameHashKey; ++iter)
+	{
+		items.push_back(m_entries[iter->second].item);
+		++found;
+	}
+
+	return found;
+}
+
+int RealEstateItemIndex::FindItemsByOwner(std::string_view ownerName, std::vector<const RealEstateItem*>& items) const
+{
+	// Names map to hash keys one to one, so find the key of any one of their items. That's a
+	// walk over the distinct owners only, comparing the names copied at Update.
+	for (auto iter = m_byOwner.begin(); iter != m_byOwner.end();)
+	{
+		int ownerNameHashKey = iter->first;
+
+		if (mq::ci_equals(m_entries[iter->second].ownerName, ownerName))
+			return FindItemsByOwner(ownerNameHashKey, items);
+
+		iter = std::upper_bound(iter, m_byOwner.end(), std::make_pair(ownerNameHashKey, INT_MAX));
+	}
+
+	return 0;
+}
+
+} // namespace eqlib
@@ -0,0 +1,119 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "RealEstate.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+// Secondary indexes over the items in a RealEstateManager's item lists: items by owner, and
+// placed items by position.
+//
+// The manager stores each real estate's items in their own hash table, so both "what does
+// this person own" and "what is near this point" are otherwise a walk over every item. The
+// index keeps a flat copy of each item's ids, owner and position, with the owner index sorted
+// by owner and the spatial index sorted by cell of a square grid over X/Y. Queries only read
+// these copies and never the items, so they're safe even if the manager freed an item since.
+//
+// Update brings the index up to date with the manager. Each item list is fingerprinted, and
+// only lists whose fingerprint changed are collected again. The sorted indexes are only rebuilt
+// if anything changed at all.
+//
+// The fingerprint Update uses by default is made of the ids and addresses stored in the list's
+// hash table, so it catches items being added, removed or replaced without reading the items.
+// Items being moved, placed or picked up don't change it: call Invalidate when the game reports
+// such a change, or pass checkItems to Update to also hash every item's position and owner.
+//
+// Item pointers handed out are the manager's and are only good until the manager changes the
+// list they came from. Call Update before querying after anything may have changed.
+class RealEstateItemIndex
+{
+public:
+	EQLIB_OBJECT RealEstateItemIndex(float cellSize = 32.0f);
+
+	// Synchronizes the index with |manager|. Returns true if anything changed. With |checkItems|
+	// every item is checked for changes, not just the item counts.
+	EQLIB_OBJECT bool Update(const RealEstateManager& manager, bool checkItems = false);
+
+	// Makes the next Update collect the items of |realEstateId| again, or of every list for -1.
+	EQLIB_OBJECT void Invalidate(int realEstateId = -1);
+
+	EQLIB_OBJECT void Clear();
+
+	// Changing the cell size empties the index, the next Update rebuilds it.
+	EQLIB_OBJECT void SetCellSize(float cellSize);
+	float GetCellSize() const { return m_cellSize; }
+
+	// Appends the placed items within |radius| of |center| to |items|. Only items from
+	// |realEstateId| are included, unless it is -1. Returns the number of items appended.
+	EQLIB_OBJECT int FindItemsInRadius(const CVector3& center, float radius, std::vector<const RealEstateItem*>& items,
+		int realEstateId = -1) const;
+
+	// Appends all items, placed or not, whose owner has the given name hash key, or the given
+	// name (case insensitive). Returns the number of items appended.
+	EQLIB_OBJECT int FindItemsByOwner(int ownerNameHashKey, std::vector<const RealEstateItem*>& items) const;
+	EQLIB_OBJECT int FindItemsByOwner(std::string_view ownerName, std::vector<const RealEstateItem*>& items) const;
+
+	int GetItemCount() const { return static_cast<int>(m_entries.size()); }
+	int GetListCount() const { return static_cast<int>(m_lists.size()); }
+
+	// Number of item lists collected again by the last Update.
+	int GetLastUpdateRescans() const { return m_lastRescans; }
+
+private:
+	struct Entry
+	{
+		const RealEstateItem* item;
+		CVector3              pos;
+		int                   realEstateId;
+		int                   ownerNameHashKey;
+		std::string           ownerName;
+		bool                  placed;
+	};
+
+	struct ListRecord
+	{
+		const RealEstateItems* items = nullptr;
+		uint64_t               fingerprint = 0;
+		uint64_t               contentFingerprint = 0;
+		std::vector<Entry>     entries;
+		bool                   seen = false;
+		bool                   invalidated = false;
+	};
+
+	static uint64_t GetFingerprint(const RealEstateItems& items);
+	static uint64_t GetContentFingerprint(const RealEstateItems& items);
+	static void HashItem(uint64_t& hash, const RealEstateItem* item);
+	uint64_t GetCellKey(float x, float y) const;
+	void Rebuild();
+
+	float m_cellSize;
+	float m_inverseCellSize;
+
+	std::unordered_map<int, ListRecord> m_lists;     // by real estate id
+	int m_lastRescans = 0;
+
+	// Flattened from m_lists, in list order. The indexes below refer into it.
+	std::vector<Entry> m_entries;
+	std::vector<std::pair<int, int>> m_byOwner;      // (owner name hash key, entry), sorted
+	std::vector<std::pair<uint64_t, int>> m_byCell;  // (cell key, entry), placed items only, sorted
+};
+
+} // namespace eqlib
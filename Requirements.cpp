@@ -0,0 +1,191 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "Requirements.h"
+
+#include <algorithm>
+
+namespace eqlib {
+
+//============================================================================
+// CompiledRequirementAssociations
+//============================================================================
+
+void CompiledRequirementAssociations::Clear()
+{
+	m_source = nullptr;
+	m_sourceEntries = 0;
+
+	m_associationIds.clear();
+	m_groupStart.clear();
+	m_requirementStart.clear();
+	m_requirements.clear();
+	m_requirementIds.clear();
+	m_requirementGeneration.clear();
+	m_requirementMet.clear();
+	m_generation = 0;
+}
+
+int CompiledRequirementAssociations::Compile(const RequirementAssociationManager& manager)
+{
+	Clear();
+
+	using GroupTable = HashTable<DoublyLinkedList<int>*>;
+	using AssociationTable = HashTable<GroupTable*>;
+
+	// Collect the association ids first, so that the rows can be laid out in id order.
+	std::vector<std::pair<int, const GroupTable*>> associations;
+	associations.reserve(manager.Requirements.GetTotalEntries());
+
+	for (auto entry = manager.Requirements.WalkFirstEntry(); entry; entry = manager.Requirements.WalkNextEntry(entry))
+		associations.emplace_back(entry->key(), entry->value());
+
+	std::sort(associations.begin(), associations.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+
+	m_associationIds.reserve(associations.size());
+	m_groupStart.reserve(associations.size() + 1);
+	m_requirementStart.push_back(0);
+
+	for (const auto& [associationId, groups] : associations)
+	{
+		m_associationIds.push_back(associationId);
+		m_groupStart.push_back(static_cast<int>(m_requirementStart.size()) - 1);
+
+		if (!groups)
+			continue;
+
+		for (auto group = groups->WalkFirstEntry(); group; group = groups->WalkNextEntry(group))
+		{
+			if (DoublyLinkedList<int>* requirements = group->value())
+			{
+				for (int requirementId : *requirements)
+					m_requirements.push_back(requirementId);
+			}
+
+			m_requirementStart.push_back(static_cast<int>(m_requirements.size()));
+		}
+	}
+
+	m_groupStart.push_back(static_cast<int>(m_requirementStart.size()) - 1);
+
+	// Number the requirements densely, so the per batch answers fit in a flat array.
+	m_requirementIds = m_requirements;
+	std::sort(m_requirementIds.begin(), m_requirementIds.end());
+	m_requirementIds.erase(std::unique(m_requirementIds.begin(), m_requirementIds.end()), m_requirementIds.end());
+
+	for (int& requirement : m_requirements)
+	{
+		requirement = static_cast<int>(std::lower_bound(m_requirementIds.begin(), m_requirementIds.end(), requirement)
+			- m_requirementIds.begin());
+	}
+
+	m_requirementGeneration.assign(m_requirementIds.size(), 0);
+	m_requirementMet.assign(m_requirementIds.size(), 0);
+	m_generation = 0;
+
+	m_source = &manager;
+	m_sourceEntries = manager.Requirements.GetTotalEntries();
+
+	return static_cast<int>(m_associationIds.size());
+}
+
+int CompiledRequirementAssociations::FindAssociation(int associationId) const
+{
+	auto iter = std::lower_bound(m_associationIds.begin(), m_associationIds.end(), associationId);
+	if (iter == m_associationIds.end() || *iter != associationId)
+		return -1;
+
+	return static_cast<int>(iter - m_associationIds.begin());
+}
+
+bool CompiledRequirementAssociations::EvaluateAssociation(int index, const Predicate& isRequirementMet)
+{
+	int firstGroup = m_groupStart[index];
+	int lastGroup = m_groupStart[index + 1];
+
+	if (firstGroup == lastGroup)
+		return true;
+
+	for (int group = firstGroup; group < lastGroup; ++group)
+	{
+		bool groupMet = true;
+
+		for (int i = m_requirementStart[group]; i < m_requirementStart[group + 1]; ++i)
+		{
+			int requirement = m_requirements[i];
+			if (m_requirementGeneration[requirement] != m_generation)
+			{
+				m_requirementGeneration[requirement] = m_generation;
+				m_requirementMet[requirement] = isRequirementMet(m_requirementIds[requirement]) ? 1 : 0;
+			}
+
+			if (!m_requirementMet[requirement])
+			{
+				groupMet = false;
+				break;
+			}
+		}
+
+		if (groupMet)
+			return true;
+	}
+
+	return false;
+}
+
+void CompiledRequirementAssociations::BeginBatch()
+{
+	if (++m_generation == 0)
+	{
+		std::fill(m_requirementGeneration.begin(), m_requirementGeneration.end(), 0);
+		m_generation = 1;
+	}
+}
+
+bool CompiledRequirementAssociations::IsMet(int associationId, const Predicate& isRequirementMet)
+{
+	int index = FindAssociation(associationId);
+	if (index == -1)
+		return true;
+
+	BeginBatch();
+
+	return EvaluateAssociation(index, isRequirementMet);
+}
+
+int CompiledRequirementAssociations::Evaluate(const int* associationIds, int numAssociations,
+	const Predicate& isRequirementMet, uint64_t* results)
+{
+	std::fill(results, results + (numAssociations + 63) / 64, uint64_t(0));
+	BeginBatch();
+
+	int numMet = 0;
+
+	for (int i = 0; i < numAssociations; ++i)
+	{
+		int index = FindAssociation(associationIds[i]);
+
+		if (index == -1 || EvaluateAssociation(index, isRequirementMet))
+		{
+			results[i >> 6] |= uint64_t(1) << (i & 63);
+			++numMet;
+		}
+	}
+
+	return numMet;
+}
+
+} // namespace eqlib
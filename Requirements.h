@@ -18,6 +18,9 @@
 #include "Containers.h"
 #include "CXStr.h"
 
+#include <functional>
+#include <vector>
+
 namespace eqlib {
 
 //----------------------------------------------------------------------------
@@ -72,4 +75,70 @@ public:
 /*0x244*/
 };
 
+//----------------------------------------------------------------------------
+
+// A flattened copy of the association -> group -> requirement tables of a
+// RequirementAssociationManager, for evaluating many associations at once.
+//
+// The associations are stored sorted by id, with their groups and requirements in
+// compressed sparse row form: each association's groups are a run in one array and each
+// group's requirements a run in another, so evaluating an association reads a few
+// contiguous ints instead of chasing hash buckets and list nodes.
+//
+// Requirement ids are numbered densely when compiled. During a batch each distinct
+// requirement is handed to the caller's predicate at most once, and everything after that
+// is a lookup of the remembered answer.
+//
+// An association is met if any of its groups has all of its requirements met. Associations
+// that aren't in the table, and associations or groups without requirements, are met.
+class CompiledRequirementAssociations
+{
+public:
+	using Predicate = std::function<bool(int requirementId)>;
+
+	// Rebuilds the tables from |manager|. Returns the number of associations compiled.
+	EQLIB_OBJECT int Compile(const RequirementAssociationManager& manager);
+
+	// True if |manager| is the one compiled from and its association table hasn't visibly
+	// changed since.
+	bool IsCompiledFrom(const RequirementAssociationManager& manager) const
+	{
+		return m_source == &manager && m_sourceEntries == manager.Requirements.GetTotalEntries();
+	}
+
+	EQLIB_OBJECT void Clear();
+
+	int GetAssociationCount() const { return static_cast<int>(m_associationIds.size()); }
+	int GetRequirementCount() const { return static_cast<int>(m_requirementIds.size()); }
+
+	// Evaluates a single association.
+	EQLIB_OBJECT bool IsMet(int associationId, const Predicate& isRequirementMet);
+
+	// Evaluates |numAssociations| associations, setting bit i of |results| (stored as 64 bit
+	// words, (numAssociations + 63) / 64 of them) if associationIds[i] is met. Returns the
+	// number of associations that are met.
+	EQLIB_OBJECT int Evaluate(const int* associationIds, int numAssociations, const Predicate& isRequirementMet,
+		uint64_t* results);
+
+private:
+	int FindAssociation(int associationId) const;
+	bool EvaluateAssociation(int index, const Predicate& isRequirementMet);
+	void BeginBatch();
+
+	const RequirementAssociationManager* m_source = nullptr;
+	int m_sourceEntries = 0;
+
+	std::vector<int> m_associationIds;     // sorted
+	std::vector<int> m_groupStart;         // association i's groups are [m_groupStart[i], m_groupStart[i + 1])
+	std::vector<int> m_requirementStart;   // group g's requirements are [m_requirementStart[g], m_requirementStart[g + 1])
+	std::vector<int> m_requirements;       // indices into m_requirementIds
+	std::vector<int> m_requirementIds;     // sorted distinct requirement ids
+
+	// A requirement has been asked about in this batch if its generation is the current one,
+	// so starting a batch doesn't need to touch every requirement.
+	std::vector<uint32_t> m_requirementGeneration;
+	std::vector<uint8_t> m_requirementMet;
+	uint32_t m_generation = 0;
+};
+
 } // namespace eqlib
@@ -0,0 +1,334 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "RosterIndex.h"
+
+#include "PlayerClient.h"
+
+namespace eqlib {
+
+static void HashBytes(uint64_t& hash, const void* data, size_t length)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+}
+
+template <typename T>
+static void HashValue(uint64_t& hash, const T& value)
+{
+	HashBytes(hash, &value, sizeof(value));
+}
+
+static void HashString(uint64_t& hash, std::string_view text)
+{
+	HashBytes(hash, text.data(), text.length());
+	HashValue(hash, text.length());
+}
+
+static uint32_t CountSlots(uint32_t slots)
+{
+	uint32_t count = 0;
+	for (; slots != 0; slots &= slots - 1)
+		++count;
+
+	return count;
+}
+
+//============================================================================
+// GroupRosterIndex
+//============================================================================
+
+GroupRosterIndex::GroupRosterIndex()
+{
+	Rebuild(nullptr);
+}
+
+uint64_t GroupRosterIndex::GetFingerprint(const CGroup* group)
+{
+	uint64_t hash = 14695981039346656037ull;
+	HashValue(hash, group);
+
+	if (group)
+	{
+		for (CGroupMember* member : *group)
+		{
+			HashValue(hash, member);
+			if (!member)
+				continue;
+
+			HashString(hash, member->Name);
+			HashString(hash, member->OwnerName);
+			HashValue(hash, member->Type);
+			HashValue(hash, member->bIsOffline);
+			HashValue(hash, member->bRoleStates);
+			HashValue(hash, member->pPlayer);
+		}
+	}
+
+	return hash;
+}
+
+bool GroupRosterIndex::Update(const CGroup* group)
+{
+	uint64_t fingerprint = GetFingerprint(group);
+	if (m_valid && fingerprint == m_fingerprint)
+		return false;
+
+	Rebuild(group);
+
+	m_fingerprint = fingerprint;
+	m_valid = true;
+	++m_rebuilds;
+	return true;
+}
+
+void GroupRosterIndex::Rebuild(const CGroup* group)
+{
+	m_memberSlots = 0;
+	m_onlineSlots = 0;
+	m_playerSlots = 0;
+	m_names.Clear();
+	m_mercenaryOwners.Clear();
+	m_playerSlotMap.clear();
+
+	for (int role = 0; role < MaxGroupRoles; ++role)
+	{
+		m_roleSlot[role] = -1;
+		m_roleSlots[role] = 0;
+	}
+
+	int position = 0;
+	for (int slot = 0; slot < MAX_GROUP_SIZE; ++slot)
+	{
+		CGroupMember* member = group ? group->GetGroupMember(slot) : nullptr;
+		m_members[slot] = member;
+		m_nthSlot[slot] = -1;
+
+		if (!member)
+			continue;
+
+		uint32_t bit = 1u << slot;
+		m_memberSlots |= bit;
+		m_nthSlot[position++] = slot;
+
+		if (!member->IsOffline())
+			m_onlineSlots |= bit;
+
+		std::string_view ownerName = member->GetOwnerName();
+		if (ownerName.empty())
+			m_playerSlots |= bit;
+		else
+			m_mercenaryOwners.Insert(ownerName, slot);
+
+		m_names.Insert(member->GetName(), slot);
+
+		if (member->pPlayer)
+			m_playerSlotMap.emplace(member->pPlayer, slot);
+
+		for (int role = 0; role < MaxGroupRoles; ++role)
+		{
+			if (member->GetRole(static_cast<eGroupRoles>(role)))
+			{
+				m_roleSlots[role] |= bit;
+				if (m_roleSlot[role] == -1)
+					m_roleSlot[role] = slot;
+			}
+		}
+	}
+}
+
+CGroupMember* GroupRosterIndex::GetGroupMember(std::string_view name) const
+{
+	int slot = m_names.Find(name);
+	return slot != -1 ? m_members[slot] : nullptr;
+}
+
+CGroupMember* GroupRosterIndex::GetGroupMember(const PlayerClient* pPlayer) const
+{
+	auto iter = m_playerSlotMap.find(pPlayer);
+	return iter != m_playerSlotMap.end() ? m_members[iter->second] : nullptr;
+}
+
+CGroupMember* GroupRosterIndex::GetMercenary(std::string_view ownerName) const
+{
+	// CGroup::GetMercenary compares owner names, so an empty name finds the first player.
+	if (ownerName.empty())
+	{
+		for (int slot = 0; slot < MAX_GROUP_SIZE; ++slot)
+		{
+			if (m_playerSlots & (1u << slot))
+				return m_members[slot];
+		}
+
+		return nullptr;
+	}
+
+	int slot = m_mercenaryOwners.Find(ownerName);
+	return slot != -1 ? m_members[slot] : nullptr;
+}
+
+CGroupMember* GroupRosterIndex::GetNthGroupMember(int position) const
+{
+	if (position < 0 || position >= MAX_GROUP_SIZE || m_nthSlot[position] == -1)
+		return nullptr;
+
+	return m_members[m_nthSlot[position]];
+}
+
+uint32_t GroupRosterIndex::GetNumberOfMembers(bool includeOffline) const
+{
+	uint32_t count = CountSlots(includeOffline ? m_memberSlots : m_onlineSlots);
+
+	// If you're by yourself, then return no members (no group).
+	return count == 1 ? 0 : count;
+}
+
+uint32_t GroupRosterIndex::GetNumberOfPlayerMembers(bool includeOffline) const
+{
+	return CountSlots(m_playerSlots & (includeOffline ? m_memberSlots : m_onlineSlots));
+}
+
+uint32_t GroupRosterIndex::GetNumberOfMembersExcludingSelf(bool includeOffline) const
+{
+	return CountSlots((includeOffline ? m_memberSlots : m_onlineSlots) & ~1u);
+}
+
+//============================================================================
+// RaidRosterIndex
+//============================================================================
+
+RaidRosterIndex::RaidRosterIndex()
+{
+}
+
+uint64_t RaidRosterIndex::GetFingerprint(const CRaid* raid)
+{
+	uint64_t hash = 14695981039346656037ull;
+	HashValue(hash, raid);
+
+	if (raid)
+	{
+		HashValue(hash, raid->RaidMemberCount);
+
+		for (int index = 0; index < MAX_RAID_SIZE; ++index)
+		{
+			HashValue(hash, raid->locations[index]);
+			if (!raid->locations[index])
+				continue;
+
+			const RaidMember& member = raid->raidMembers[index];
+			HashString(hash, std::string_view(member.Name, strnlen(member.Name, EQ_MAX_NAME)));
+			HashValue(hash, member.nClass);
+			HashValue(hash, member.RaidLeader);
+			HashValue(hash, member.GroupLeader);
+			HashValue(hash, member.RaidMainAssist);
+			HashValue(hash, member.RaidMarker);
+			HashValue(hash, member.MasterLooter);
+			HashValue(hash, member.GroupNumber);
+		}
+	}
+
+	return hash;
+}
+
+bool RaidRosterIndex::Update(const CRaid* raid)
+{
+	uint64_t fingerprint = GetFingerprint(raid);
+	if (m_valid && fingerprint == m_fingerprint)
+		return false;
+
+	Rebuild(raid);
+
+	m_fingerprint = fingerprint;
+	m_valid = true;
+	++m_rebuilds;
+	return true;
+}
+
+void RaidRosterIndex::Rebuild(const CRaid* raid)
+{
+	m_raid = raid;
+	m_members.reset();
+	m_raidLeaders.reset();
+	m_groupLeaders.reset();
+	m_mainAssists.reset();
+	m_markers.reset();
+	m_masterLooters.reset();
+	for (MemberSet& group : m_groups)
+		group.reset();
+	m_classes.clear();
+	m_names.Clear();
+
+	if (!raid)
+		return;
+
+	for (int index = 0; index < MAX_RAID_SIZE; ++index)
+	{
+		if (!raid->locations[index])
+			continue;
+
+		const RaidMember& member = raid->raidMembers[index];
+
+		m_members.set(index);
+		m_raidLeaders.set(index, member.RaidLeader);
+		m_groupLeaders.set(index, member.GroupLeader);
+		m_mainAssists.set(index, member.RaidMainAssist);
+		m_markers.set(index, member.RaidMarker);
+		m_masterLooters.set(index, member.MasterLooter != 0);
+
+		int groupNumber = member.GroupNumber;
+		m_groups[groupNumber >= 0 && groupNumber < MaxRaidGroups ? groupNumber + 1 : 0].set(index);
+
+		m_classes[member.nClass].set(index);
+		m_names.Insert(std::string_view(member.Name, strnlen(member.Name, EQ_MAX_NAME)), index);
+	}
+}
+
+const RaidMember* RaidRosterIndex::GetRaidMember(std::string_view name) const
+{
+	return GetRaidMember(m_names.Find(name));
+}
+
+const RaidMember* RaidRosterIndex::GetRaidMember(const PlayerClient* pPlayer) const
+{
+	if (!pPlayer)
+		return nullptr;
+
+	return GetRaidMember(m_names.Find(pPlayer->Name));
+}
+
+const RaidRosterIndex::MemberSet& RaidRosterIndex::GetGroupMembers(int groupNumber) const
+{
+	static const MemberSet s_noMembers;
+
+	if (groupNumber < -1 || groupNumber >= MaxRaidGroups)
+		return s_noMembers;
+
+	return m_groups[groupNumber + 1];
+}
+
+const RaidRosterIndex::MemberSet& RaidRosterIndex::GetClassMembers(int classId) const
+{
+	static const MemberSet s_noMembers;
+
+	auto iter = m_classes.find(classId);
+	return iter != m_classes.end() ? iter->second : s_noMembers;
+}
+
+} // namespace eqlib
@@ -0,0 +1,253 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "EQData.h"
+#include "PcClient.h"
+
+#include <bitset>
+#include <string_view>
+#include <unordered_map>
+
+namespace eqlib {
+
+// Case insensitive name -> index table with a fixed number of buckets, used by the roster
+// indexes below. Names are copied, so the table stays safe to query after the game frees them.
+template <int MaxEntries>
+class RosterNameTable
+{
+public:
+	static constexpr int BucketCount = 256;
+	static_assert(BucketCount >= MaxEntries * 2, "too many entries for the bucket count");
+
+	RosterNameTable() { Clear(); }
+
+	void Clear()
+	{
+		for (int& bucket : m_buckets)
+			bucket = -1;
+	}
+
+	// Adds |name| for |index|, which must be below MaxEntries. If the name is already in the
+	// table the first index is kept, like a scan in index order would find.
+	void Insert(std::string_view name, int index)
+	{
+		name = name.substr(0, EQ_MAX_NAME - 1);
+		uint32_t hash = HashName(name);
+
+		for (uint32_t bucket = hash & (BucketCount - 1);; bucket = (bucket + 1) & (BucketCount - 1))
+		{
+			int existing = m_buckets[bucket];
+			if (existing == -1)
+			{
+				m_buckets[bucket] = index;
+				m_hashes[index] = hash;
+				memcpy(m_names[index], name.data(), name.length());
+				m_names[index][name.length()] = 0;
+				return;
+			}
+
+			if (m_hashes[existing] == hash && mq::ci_equals(name, m_names[existing]))
+				return;
+		}
+	}
+
+	// Returns the index for |name|, or -1.
+	int Find(std::string_view name) const
+	{
+		uint32_t hash = HashName(name);
+
+		for (uint32_t bucket = hash & (BucketCount - 1);; bucket = (bucket + 1) & (BucketCount - 1))
+		{
+			int index = m_buckets[bucket];
+			if (index == -1)
+				return -1;
+
+			if (m_hashes[index] == hash && mq::ci_equals(name, m_names[index]))
+				return index;
+		}
+	}
+
+	static uint32_t HashName(std::string_view name)
+	{
+		uint32_t hash = 2166136261u;
+		for (char ch : name)
+		{
+			hash ^= static_cast<uint8_t>((ch >= 'A' && ch <= 'Z') ? ch - 'A' + 'a' : ch);
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+private:
+	int      m_buckets[BucketCount];
+	uint32_t m_hashes[MaxEntries];
+	char     m_names[MaxEntries][EQ_MAX_NAME];
+};
+
+//============================================================================
+// GroupRosterIndex
+//============================================================================
+
+// A snapshot of the group that answers the CGroup lookups without walking the members.
+//
+// CGroup::GetGroupMember(name), GetMercenary, GetGroupMemberByRole, GetNthGroupMember and the
+// GetNumberOf*Members functions each walk m_groupMembers and compare names. The index builds a
+// name table, a player pointer table, a role -> members table and online/player bitsets once,
+// and answers each of those in constant time until the group changes.
+//
+// Update compares a fingerprint of the group (member pointers, names, roles, offline flags and
+// player pointers) with the one the index was built from, and only rebuilds if it differs, so
+// it is cheap to call every frame. Invalidate forces the next Update to rebuild, for callers
+// that hear about group changes some other way.
+//
+// Slots are the CGroup member array indexes, bit N of a bitset is slot N.
+class GroupRosterIndex
+{
+public:
+	EQLIB_OBJECT GroupRosterIndex();
+
+	// Brings the index up to date with |group|, which may be null (not grouped). Returns true if
+	// the index was rebuilt.
+	EQLIB_OBJECT bool Update(const CGroup* group);
+	void Invalidate() { m_valid = false; }
+
+	EQLIB_OBJECT CGroupMember* GetGroupMember(std::string_view name) const;
+	EQLIB_OBJECT CGroupMember* GetGroupMember(const PlayerClient* pPlayer) const;
+	EQLIB_OBJECT CGroupMember* GetMercenary(std::string_view ownerName) const;
+	EQLIB_OBJECT CGroupMember* GetNthGroupMember(int position) const;
+
+	CGroupMember* GetGroupMemberByRole(eGroupRoles role) const
+	{
+		return role >= 0 && role < MaxGroupRoles && m_roleSlot[role] != -1 ? m_members[m_roleSlot[role]] : nullptr;
+	}
+
+	CGroupMember* GetGroupMember(int slot) const
+	{
+		return slot >= 0 && slot < MAX_GROUP_SIZE ? m_members[slot] : nullptr;
+	}
+
+	// Same results as the CGroup functions of the same name.
+	EQLIB_OBJECT uint32_t GetNumberOfMembers(bool includeOffline = true) const;
+	EQLIB_OBJECT uint32_t GetNumberOfPlayerMembers(bool includeOffline = true) const;
+	EQLIB_OBJECT uint32_t GetNumberOfMembersExcludingSelf(bool includeOffline = true) const;
+
+	uint32_t GetMemberSlots() const { return m_memberSlots; }
+	uint32_t GetOnlineSlots() const { return m_onlineSlots; }
+	uint32_t GetPlayerSlots() const { return m_playerSlots; }      // not mercenaries
+	uint32_t GetRoleSlots(eGroupRoles role) const { return role >= 0 && role < MaxGroupRoles ? m_roleSlots[role] : 0; }
+
+	// Slot of a member, or -1.
+	int GetSlot(std::string_view name) const { return m_names.Find(name); }
+
+	uint32_t GetRebuildCount() const { return m_rebuilds; }
+
+private:
+	static uint64_t GetFingerprint(const CGroup* group);
+	void Rebuild(const CGroup* group);
+
+	CGroupMember* m_members[MAX_GROUP_SIZE];
+	int           m_nthSlot[MAX_GROUP_SIZE];           // position among occupied slots -> slot
+	int           m_roleSlot[MaxGroupRoles];           // first slot with the role, or -1
+	uint32_t      m_roleSlots[MaxGroupRoles];
+	uint32_t      m_memberSlots = 0;
+	uint32_t      m_onlineSlots = 0;
+	uint32_t      m_playerSlots = 0;
+
+	RosterNameTable<MAX_GROUP_SIZE> m_names;
+	RosterNameTable<MAX_GROUP_SIZE> m_mercenaryOwners;
+	std::unordered_map<const PlayerClient*, int> m_playerSlotMap;
+
+	uint64_t      m_fingerprint = 0;
+	bool          m_valid = false;
+	uint32_t      m_rebuilds = 0;
+};
+
+//============================================================================
+// RaidRosterIndex
+//============================================================================
+
+// A snapshot of the raid roster, with the same idea as GroupRosterIndex.
+//
+// Raid members are found by name, by raid group, and by their leader, main assist, marker and
+// master looter flags, as bitsets over CRaid's member array indexes. Raid members don't carry a
+// player pointer, so a PlayerClient is looked up by its name, which stays correct as players
+// zone in and out without the raid changing.
+class RaidRosterIndex
+{
+public:
+	using MemberSet = std::bitset<MAX_RAID_SIZE>;
+
+	// Raid groups are numbered 0-11, members that aren't in a group have -1.
+	static constexpr int MaxRaidGroups = 12;
+
+	EQLIB_OBJECT RaidRosterIndex();
+
+	// Brings the index up to date with |raid|, which may be null. Returns true if the index was
+	// rebuilt.
+	EQLIB_OBJECT bool Update(const CRaid* raid);
+	void Invalidate() { m_valid = false; }
+
+	EQLIB_OBJECT const RaidMember* GetRaidMember(std::string_view name) const;
+	EQLIB_OBJECT const RaidMember* GetRaidMember(const PlayerClient* pPlayer) const;
+
+	const RaidMember* GetRaidMember(int index) const
+	{
+		return index >= 0 && index < MAX_RAID_SIZE && m_members.test(index) ? &m_raid->raidMembers[index] : nullptr;
+	}
+
+	// Member array index of a member, or -1.
+	int GetIndex(std::string_view name) const { return m_names.Find(name); }
+
+	int GetMemberCount() const { return static_cast<int>(m_members.count()); }
+
+	const MemberSet& GetMembers() const { return m_members; }
+	const MemberSet& GetRaidLeaders() const { return m_raidLeaders; }
+	const MemberSet& GetGroupLeaders() const { return m_groupLeaders; }
+	const MemberSet& GetMainAssists() const { return m_mainAssists; }
+	const MemberSet& GetMarkers() const { return m_markers; }
+	const MemberSet& GetMasterLooters() const { return m_masterLooters; }
+
+	// Members of raid group |groupNumber|, or the ungrouped members for -1.
+	EQLIB_OBJECT const MemberSet& GetGroupMembers(int groupNumber) const;
+
+	// Members of the given class.
+	EQLIB_OBJECT const MemberSet& GetClassMembers(int classId) const;
+
+	uint32_t GetRebuildCount() const { return m_rebuilds; }
+
+private:
+	static uint64_t GetFingerprint(const CRaid* raid);
+	void Rebuild(const CRaid* raid);
+
+	const CRaid*  m_raid = nullptr;
+	MemberSet     m_members;
+	MemberSet     m_raidLeaders;
+	MemberSet     m_groupLeaders;
+	MemberSet     m_mainAssists;
+	MemberSet     m_markers;
+	MemberSet     m_masterLooters;
+	MemberSet     m_groups[MaxRaidGroups + 1];         // [0] is ungrouped
+	std::unordered_map<int, MemberSet> m_classes;
+
+	RosterNameTable<MAX_RAID_SIZE> m_names;
+
+	uint64_t      m_fingerprint = 0;
+	bool          m_valid = false;
+	uint32_t      m_rebuilds = 0;
+};
+
+} // namespace eqlib
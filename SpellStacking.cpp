@@ -0,0 +1,212 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "SpellStacking.h"
+
+#include "EQLib.h"
+
+#include <intrin.h>
+
+namespace eqlib {
+
+SpellStackingEngine::SpellStackingEngine(size_t pairCacheSize)
+	: m_pairCacheCapacity(pairCacheSize)
+{
+}
+
+void SpellStackingEngine::Clear()
+{
+	m_signatures.clear();
+	m_pairLRU.clear();
+	m_pairCache.clear();
+}
+
+void SpellStackingEngine::CheckSpellsReloaded()
+{
+	if (!pSpellMgr)
+		return;
+
+	if (pSpellMgr->SpellFileCRC != m_spellFileCRC || pSpellMgr->SpellStackingFileCRC != m_stackingFileCRC)
+	{
+		Clear();
+
+		m_spellFileCRC = pSpellMgr->SpellFileCRC;
+		m_stackingFileCRC = pSpellMgr->SpellStackingFileCRC;
+	}
+}
+
+void SpellStackingEngine::BuildSignature(ClientSpellManager* pSpellManager, const EQ_Spell* pSpell,
+	SpellStackingSignature& signature)
+{
+	signature = SpellStackingSignature();
+	signature.spellId = pSpell->ID;
+	signature.noOverwrite = pSpell->GetNoOverwrite();
+	signature.beneficial = pSpell->IsBeneficialSpell();
+
+	signature.groupId = pSpellManager->GetSpellStackingGroupID(pSpell->ID);
+	if (signature.groupId != 0)
+	{
+		signature.groupRank = pSpellManager->GetSpellStackingGroupRank(pSpell->ID);
+		signature.groupRule = pSpellManager->GetSpellStackingGroupRule(pSpell->ID);
+	}
+
+	for (int index = 0; index < pSpell->GetNumEffects(); ++index)
+	{
+		const SpellAffectData* affect = pSpellManager->GetSpellAffect(pSpell->CalcIndex + index);
+		if (!affect || affect->Slot < 1 || affect->Slot > SPELL_STACKING_MAX_SLOT)
+			continue;
+
+		if (affect->Attrib == SPA_NOSPELL
+			|| !EQ_Spell::IsSPAStacking(affect->Attrib)
+			|| EQ_Spell::IsSPAIgnoredByStacking(affect->Attrib))
+		{
+			continue;
+		}
+
+		int slot = affect->Slot - 1;
+		signature.slotMask |= 1u << slot;
+		signature.slotSPA[slot] = static_cast<int16_t>(affect->Attrib);
+		signature.slotBase[slot] = static_cast<int32_t>(std::clamp<int64_t>(affect->Base, INT32_MIN, INT32_MAX));
+	}
+}
+
+const SpellStackingSignature* SpellStackingEngine::GetSignature(int spellId)
+{
+	CheckSpellsReloaded();
+
+	auto iter = m_signatures.find(spellId);
+	if (iter != m_signatures.end())
+		return iter->second.get();
+
+	if (!pSpellMgr)
+		return nullptr;
+
+	EQ_Spell* pSpell = pSpellMgr->GetSpellByID(spellId);
+	if (!pSpell || pSpell->ID != spellId)
+		return nullptr;
+
+	auto signature = std::make_unique<SpellStackingSignature>();
+	BuildSignature(pSpellMgr, pSpell, *signature);
+
+	return m_signatures.emplace(spellId, std::move(signature)).first->second.get();
+}
+
+bool SpellStackingEngine::DoesBlock(const SpellStackingSignature& existing, const SpellStackingSignature& candidate)
+{
+	if (existing.noOverwrite == NoOverwrite_AllSpells)
+		return true;
+
+	// Recasting the same spell just refreshes it.
+	if (existing.spellId == candidate.spellId)
+		return false;
+
+	if (existing.noOverwrite == NoOverwrite_OtherSpells)
+		return true;
+
+	if (existing.groupId != 0 && existing.groupId == candidate.groupId)
+	{
+		switch (candidate.groupRule)
+		{
+		case ESSR_SingleCasterAlwaysOverwrite:
+		case ESSR_AllCastersAlwaysOverwrite:
+			return false;
+
+		case ESSR_SingleCasterNeverOverwrite:
+		case ESSR_AllCastersNeverOverwrite:
+			return true;
+
+		case ESSR_SingleCasterOnlyGreater:
+		case ESSR_AllCastersOnlyGreater:
+			return candidate.groupRank <= existing.groupRank;
+
+		default:
+			return candidate.groupRank < existing.groupRank;
+		}
+	}
+
+	// Beneficial and detrimental effects never compete for a slot.
+	if (existing.beneficial != candidate.beneficial)
+		return false;
+
+	uint32_t overlap = existing.slotMask & candidate.slotMask;
+	while (overlap)
+	{
+		unsigned long slot;
+		_BitScanForward(&slot, overlap);
+		overlap &= overlap - 1;
+
+		if (existing.slotSPA[slot] == candidate.slotSPA[slot]
+			&& std::abs(static_cast<int64_t>(candidate.slotBase[slot])) < std::abs(static_cast<int64_t>(existing.slotBase[slot])))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool SpellStackingEngine::DoesBlock(int existingSpellId, int candidateSpellId)
+{
+	const SpellStackingSignature* existing = GetSignature(existingSpellId);
+	const SpellStackingSignature* candidate = GetSignature(candidateSpellId);
+	if (!existing || !candidate)
+		return false;
+
+	// Most pairs share nothing at all, and that's cheaper to see than to look up.
+	if ((existing->slotMask & candidate->slotMask) == 0
+		&& (existing->groupId == 0 || existing->groupId != candidate->groupId)
+		&& existing->noOverwrite == NoOverwrite_Default)
+	{
+		return false;
+	}
+
+	uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(existingSpellId)) << 32) | static_cast<uint32_t>(candidateSpellId);
+
+	auto iter = m_pairCache.find(key);
+	if (iter != m_pairCache.end())
+	{
+		m_pairLRU.splice(m_pairLRU.begin(), m_pairLRU, iter->second);
+		return iter->second->second;
+	}
+
+	bool blocked = DoesBlock(*existing, *candidate);
+
+	if (m_pairCacheCapacity > 0)
+	{
+		if (m_pairCache.size() >= m_pairCacheCapacity)
+		{
+			m_pairCache.erase(m_pairLRU.back().first);
+			m_pairLRU.pop_back();
+		}
+
+		m_pairLRU.emplace_front(key, blocked);
+		m_pairCache.emplace(key, m_pairLRU.begin());
+	}
+
+	return blocked;
+}
+
+int SpellStackingEngine::FindBlockingEffect(int candidateSpellId, const EQ_Affect* effects, int numEffects)
+{
+	for (int i = 0; i < numEffects; ++i)
+	{
+		if (effects[i].SpellID > 0 && DoesBlock(effects[i].SpellID, candidateSpellId))
+			return i;
+	}
+
+	return -1;
+}
+
+} // namespace eqlib
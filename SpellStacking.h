@@ -0,0 +1,110 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Spells.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace eqlib {
+
+// Highest effect slot that takes part in the slot/SPA comparison. Slots are 1-based.
+constexpr int SPELL_STACKING_MAX_SLOT = 32;
+
+// Everything about a spell that matters for stacking, in a form that can be compared without
+// going back to the spell manager.
+struct SpellStackingSignature
+{
+	int                 spellId = 0;
+	int                 groupId = 0;
+	int                 groupRank = 0;
+	ESpellStackingRules groupRule = ESSR_None;
+	int                 noOverwrite = NoOverwrite_Default;
+	bool                beneficial = false;
+
+	// Bit (slot - 1) is set for every slot with an SPA that stacking looks at.
+	uint32_t            slotMask = 0;
+	int16_t             slotSPA[SPELL_STACKING_MAX_SLOT] = { 0 };
+	int32_t             slotBase[SPELL_STACKING_MAX_SLOT] = { 0 };
+};
+
+// Answers "would spell A, already on a target, keep spell B from landing" for many spells
+// and targets at once.
+//
+// Each spell's stacking group, rank and rule, and the SPA and base value in each of its effect
+// slots, are read once from the spell manager and kept as a SpellStackingSignature. Two spells
+// that share neither a stacking group nor a stacking slot can't conflict, which is a single
+// AND of their slot masks. Pairs that do overlap are resolved from the signatures and the
+// results kept in an LRU.
+//
+// The rules applied are the common ones: no-overwrite flags, stacking group rank and rule,
+// and same-SPA-in-the-same-slot with the stronger effect winning. Caster-specific group rules
+// are treated like their all-caster forms. This is meant for planning (which of these spells
+// is worth casting on whom), CharacterZoneClient::IsStackBlocked remains the final word.
+class SpellStackingEngine
+{
+public:
+	EQLIB_OBJECT SpellStackingEngine(size_t pairCacheSize = 8192);
+
+	// Returns the signature for a spell, building it if needed. Returns nullptr for unknown
+	// spells or if spells are not loaded.
+	EQLIB_OBJECT const SpellStackingSignature* GetSignature(int spellId);
+
+	// Returns true if |existingSpellId|, already on a target, prevents |candidateSpellId| from
+	// landing on it.
+	EQLIB_OBJECT bool DoesBlock(int existingSpellId, int candidateSpellId);
+
+	// Returns the index of the first effect in |effects| that blocks |candidateSpellId|, or -1
+	// if none of them do.
+	EQLIB_OBJECT int FindBlockingEffect(int candidateSpellId, const EQ_Affect* effects, int numEffects);
+
+	bool WillLand(int candidateSpellId, const EQ_Affect* effects, int numEffects)
+	{
+		return FindBlockingEffect(candidateSpellId, effects, numEffects) == -1;
+	}
+
+	// Drops all signatures and cached results. This happens automatically if the spell or
+	// stacking files are reloaded.
+	EQLIB_OBJECT void Clear();
+
+	size_t GetSignatureCount() const { return m_signatures.size(); }
+	size_t GetPairCacheSize() const { return m_pairCache.size(); }
+
+	// Compares two signatures directly.
+	EQLIB_OBJECT static bool DoesBlock(const SpellStackingSignature& existing, const SpellStackingSignature& candidate);
+
+	// Builds the signature for |pSpell|, using the stacking group data from |pSpellManager|.
+	EQLIB_OBJECT static void BuildSignature(ClientSpellManager* pSpellManager, const EQ_Spell* pSpell,
+		SpellStackingSignature& signature);
+
+private:
+	void CheckSpellsReloaded();
+
+	// Signatures are heap allocated so the pointers handed out stay put.
+	std::unordered_map<int, std::unique_ptr<SpellStackingSignature>> m_signatures;
+
+	// Pairwise results, most recently used at the front.
+	using PairEntry = std::pair<uint64_t, bool>;
+	std::list<PairEntry> m_pairLRU;
+	std::unordered_map<uint64_t, std::list<PairEntry>::iterator> m_pairCache;
+	size_t m_pairCacheCapacity;
+
+	int m_spellFileCRC = 0;
+	int m_stackingFileCRC = 0;
+};
+
+} // namespace eqlib
@@ -1410,6 +1410,18 @@ public:
 		int Percent;
 	};
 
+	// Looks up entries the game has already cached, using the game's keys.
+	const CachedFocusItem* FindCachedFocusItem(int64_t key) const { return CachedFocusItems.FindFirst(key); }
+	const CachedFocusEffect* FindCachedFocusEffect(int64_t key) const { return CachedFocusEffects.FindFirst(key); }
+	const CachedFocusAbility* FindCachedFocusAbility(int64_t key) const { return CachedFocusAbilities.FindFirst(key); }
+	const CachedFocusMercAbility* FindCachedFocusMercAbility(int64_t key) const { return CachedFocusMercAbilities.FindFirst(key); }
+
+	int GetCachedFocusCount() const
+	{
+		return CachedFocusItems.GetTotalEntries() + CachedFocusEffects.GetTotalEntries()
+			+ CachedFocusAbilities.GetTotalEntries() + CachedFocusMercAbilities.GetTotalEntries();
+	}
+
 /*0x00*/ HashTable<EffectCache>*                    pCachedEffects;
 /*0x08*/ bool                                       bCachedSpellEffects;
 /*0x10*/ HashTable<AltEffectCache>*                 pCachedAltAbilityEffects;
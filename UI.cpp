@@ -473,6 +473,136 @@ CXStr CPageWnd::GetTabText(bool bShowFlashing) const
 	return TabText;
 }
 
+//============================================================================
+// STMLAppendBuffer
+//============================================================================
+
+// Starting capacity when the buffer defers to the window's own limit. It grows from there.
+constexpr int STML_APPEND_DEFAULT_CAPACITY = 400;
+
+STMLAppendBuffer::STMLAppendBuffer(int maxLines)
+{
+	SetMaxLines(maxLines);
+}
+
+void STMLAppendBuffer::SetMaxLines(int maxLines)
+{
+	m_maxLines = std::max(maxLines, 0);
+
+	Resize(m_maxLines > 0 ? m_maxLines : STML_APPEND_DEFAULT_CAPACITY);
+}
+
+void STMLAppendBuffer::Resize(int capacity)
+{
+	if (capacity == static_cast<int>(m_lines.size()))
+		return;
+
+	// Keep the newest lines that still fit, in order.
+	std::vector<CXStr> lines(capacity);
+	int keep = std::min(m_count, capacity);
+	int first = m_count - keep;
+
+	for (int i = 0; i < keep; ++i)
+	{
+		lines[i] = std::move(m_lines[(m_head + first + i) % m_lines.size()]);
+	}
+
+	m_dropped += first;
+	m_lines = std::move(lines);
+	m_head = 0;
+	m_count = keep;
+}
+
+void STMLAppendBuffer::Append(std::string_view stmlText)
+{
+	const int capacity = static_cast<int>(m_lines.size());
+	int slot = (m_head + m_count) % capacity;
+
+	if (m_count == capacity && m_maxLines == 0)
+	{
+		// The limit isn't known until the window is flushed, so nothing can be dropped yet.
+		Resize(capacity * 2);
+		Append(stmlText);
+		return;
+	}
+
+	if (m_count == capacity)
+	{
+		// Full: the oldest line would be stripped from the window anyway, so drop it now.
+		m_head = (m_head + 1) % capacity;
+		++m_dropped;
+	}
+	else
+	{
+		++m_count;
+	}
+
+	m_lines[slot].assign(stmlText);
+}
+
+void STMLAppendBuffer::Clear()
+{
+	for (CXStr& line : m_lines)
+		line.clear();
+
+	m_head = 0;
+	m_count = 0;
+	m_dropped = 0;
+}
+
+CXSize STMLAppendBuffer::Flush(CStmlWnd* pWnd)
+{
+	if (!pWnd || m_count == 0)
+		return CXSize();
+
+	const int capacity = static_cast<int>(m_lines.size());
+	int maxLines = m_maxLines > 0 ? m_maxLines : pWnd->MaxLines;
+
+	// Don't append lines that the window would just strip right away.
+	int first = 0;
+	if (maxLines > 0 && m_count > maxLines)
+	{
+		first = m_count - maxLines;
+		m_dropped += first;
+	}
+
+	size_t length = 0;
+	for (int i = first; i < m_count; ++i)
+		length += m_lines[(m_head + i) % capacity].length();
+
+	m_block.clear();
+	m_block.reserve(length);
+
+	for (int i = first; i < m_count; ++i)
+	{
+		CXStr& line = m_lines[(m_head + i) % capacity];
+
+		m_block.append(line.data(), line.length());
+		line.clear();
+	}
+
+	m_head = 0;
+	m_count = 0;
+
+	// Deferring to the window: make room for as many lines as it keeps, so the queue doesn't
+	// have to grow its way there again.
+	if (m_maxLines == 0 && pWnd->MaxLines > capacity)
+		Resize(pWnd->MaxLines);
+
+	CXSize size = pWnd->AppendSTML(m_block);
+
+	if (maxLines > 0)
+	{
+		int excess = pWnd->GetLineCount() - maxLines;
+		if (excess > 0)
+		{
+			pWnd->StripFirstSTMLLines(excess);
+		}
+	}
+
+	return size;
+}
+
 //============================================================================
 // CTabWnd
 //============================================================================
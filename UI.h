@@ -1407,6 +1407,7 @@ public:
 	EQLIB_OBJECT void UpdateHistoryString(int32_t, const CXStr&);
 
 	inline CXStr GetSTMLText() const { return STMLText; }
+	inline int GetLineCount() const { return TextLines.GetLength(); }
 
 	//----------------------------------------------------------------------------
 	// data members
@@ -1443,6 +1444,53 @@ public:
 /*0x35c*/
 };
 
+// Bounded queue of STML text waiting to be appended to a CStmlWnd. Each call to
+// CStmlWnd::AppendSTML parses and lays out the text it is given, and a busy chat window
+// then immediately strips its oldest lines again. This collects lines as they arrive and
+// appends them to the window as a single block when flushed, so the window parses once
+// per flush instead of once per line. Queueing is O(1): when more lines are queued than
+// the window is allowed to keep, the oldest queued lines are overwritten before they are
+// ever parsed, and the window is trimmed with a single StripFirstSTMLLines call. When the
+// limit is the window's own, it isn't known until the flush, so the queue grows instead.
+class STMLAppendBuffer
+{
+public:
+	EQLIB_OBJECT explicit STMLAppendBuffer(int maxLines = 0);
+
+	// The maximum number of lines that should remain in the window after a flush. This is
+	// also the capacity of the queue. A value of 0 defers to CStmlWnd::MaxLines, which is
+	// applied when flushing, and lets the queue grow as needed until then.
+	EQLIB_OBJECT void SetMaxLines(int maxLines);
+	int GetMaxLines() const { return m_maxLines; }
+
+	// Queues a line of STML text. The text is appended to the window as-is, so it should
+	// carry its own line break (e.g. a leading "<br>").
+	EQLIB_OBJECT void Append(std::string_view stmlText);
+
+	int GetPendingCount() const { return m_count; }
+	bool IsEmpty() const { return m_count == 0; }
+
+	// Number of lines that were discarded because they were pushed out of the queue before
+	// being flushed.
+	int GetDroppedCount() const { return m_dropped; }
+
+	EQLIB_OBJECT void Clear();
+
+	// Appends all pending lines to the window and trims the window down to its line limit.
+	// Returns the result of the AppendSTML call, or an empty size if nothing was pending.
+	EQLIB_OBJECT CXSize Flush(CStmlWnd* pWnd);
+
+private:
+	void Resize(int capacity);
+
+	std::vector<CXStr> m_lines;
+	int m_maxLines = 0;
+	int m_head = 0;
+	int m_count = 0;
+	int m_dropped = 0;
+	CXStr m_block;
+};
+
 //============================================================================
 // CTabWnd
 //============================================================================
@@ -504,6 +504,39 @@ CUITexturePiece::CUITexturePiece(const CUITextureInfo& ti)
 // CTextureAnimation
 //============================================================================
 
+static uint32_t GetDefaultAnimationTicks()
+{
+	return GetTickCount();
+}
+
+static CTextureAnimation::ClockFunction s_animationClock = GetDefaultAnimationTicks;
+static bool s_animationClockLatched = false;
+static uint32_t s_animationClockTicks = 0;
+
+void CTextureAnimation::SetClock(ClockFunction clock)
+{
+	s_animationClock = clock ? clock : GetDefaultAnimationTicks;
+
+	if (s_animationClockLatched)
+		s_animationClockTicks = s_animationClock();
+}
+
+void CTextureAnimation::LatchClock()
+{
+	s_animationClockTicks = s_animationClock();
+	s_animationClockLatched = true;
+}
+
+void CTextureAnimation::UnlatchClock()
+{
+	s_animationClockLatched = false;
+}
+
+uint32_t CTextureAnimation::GetClockTicks()
+{
+	return s_animationClockLatched ? s_animationClockTicks : s_animationClock();
+}
+
 CTextureAnimation::CTextureAnimation()
 {
 }
@@ -560,7 +593,7 @@ int CTextureAnimation::AddFrame(CUITexturePiece tp, uint32_t ticks, CXPoint hots
 
 	Frames.Add(frame);
 
-	TotalTicks += TotalTicks;
+	TotalTicks += ticks;
 
 	return Frames.GetLength() - 1;
 }
@@ -579,7 +612,7 @@ void CTextureAnimation::SetCurFrame(int frame)
 	if (!bGrid)
 	{
 		ZeroFrame = frame;
-		StartTicks = GetTickCount();
+		StartTicks = GetClockTicks();
 	}
 }
 
@@ -597,8 +630,9 @@ int CTextureAnimation::GetCurFrame() const
 	if (bGrid || TotalTicks == 0 || bPaused)
 		return ZeroFrame;
 
+	uint32_t delta = GetClockTicks() - StartTicks;
+
 	// run through the frames until we accumulate enough ticks to reach the delta.
-	uint32_t delta = GetTickCount() - StartTicks;
 
 	// if we aren't a cycling texture, then we only need to check frames until we
 	// reach the end. if we get to the end then we just return the last texture.
@@ -653,7 +687,7 @@ void CTextureAnimation::Pause(bool pause)
 			ZeroFrame = GetCurFrame();
 		}
 
-		StartTicks = GetTickCount();
+		StartTicks = GetClockTicks();
 	}
 }
 
@@ -669,4 +703,76 @@ CXPoint CTextureAnimation::GetHotspot() const
 	return {};
 }
 
+//============================================================================
+// CTextureAnimationTimeline
+//============================================================================
+
+// Animations with fewer frames than this are quicker to walk than to search.
+constexpr int TextureAnimationTimelineMinFrames = 16;
+
+bool CTextureAnimationTimeline::IsBuiltFrom(const CTextureAnimation& anim) const
+{
+	int count = anim.Frames.GetLength();
+
+	return count == m_count
+		&& count > 0
+		&& &anim.Frames[0] == m_frames
+		&& anim.TotalTicks == m_totalTicks;
+}
+
+void CTextureAnimationTimeline::Build(const CTextureAnimation& anim)
+{
+	int count = anim.Frames.GetLength();
+
+	m_frames = count > 0 ? &anim.Frames[0] : nullptr;
+	m_count = count;
+	m_totalTicks = anim.TotalTicks;
+	m_startTicks.resize(count + 1);
+
+	uint32_t ticks = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		m_startTicks[i] = ticks;
+		ticks += anim.Frames[i].Ticks;
+	}
+	m_startTicks[count] = ticks;
+}
+
+void CTextureAnimationTimeline::Reset()
+{
+	m_frames = nullptr;
+	m_count = 0;
+	m_totalTicks = 0;
+	m_startTicks.clear();
+}
+
+int CTextureAnimationTimeline::GetCurFrame(const CTextureAnimation& anim)
+{
+	int count = anim.Frames.GetLength();
+
+	if (count < TextureAnimationTimelineMinFrames || anim.bGrid || anim.TotalTicks == 0 || anim.bPaused)
+		return anim.GetCurFrame();
+
+	if (!IsBuiltFrom(anim))
+		Build(anim);
+
+	// Frames that were changed in place don't add up to the total, walk them instead.
+	if (m_startTicks[count] != anim.TotalTicks)
+		return anim.GetCurFrame();
+
+	uint32_t totalTicks = anim.TotalTicks;
+	uint32_t delta = CTextureAnimation::GetClockTicks() - anim.StartTicks;
+
+	// A non-cycling animation stops on its last frame.
+	if (!anim.bCycle && delta > totalTicks - m_startTicks[anim.ZeroFrame])
+		return count - 1;
+
+	// Where we are in the animation, counting from frame 0, and the last frame that starts at or
+	// before that.
+	uint32_t position = (m_startTicks[anim.ZeroFrame] + delta % totalTicks) % totalTicks;
+
+	return static_cast<int>(std::upper_bound(m_startTicks.begin(), m_startTicks.begin() + count, position)
+		- m_startTicks.begin()) - 1;
+}
+
 } // namespace eqlib
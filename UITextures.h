@@ -18,6 +18,8 @@
 #include "Containers.h"
 #include "CXStr.h"
 
+#include <vector>
+
 namespace eqlib {
 
 //============================================================================
@@ -144,13 +146,25 @@ public:
 
 	const CUITexturePiece& GetCurTexturePiece() const { return Frames[GetCurFrame()].Piece; }
 
+	// Animations are timed with GetTickCount unless another clock is set. Passing nullptr
+	// restores the default.
+	using ClockFunction = uint32_t(*)();
+	EQLIB_OBJECT static void SetClock(ClockFunction clock);
+
+	// While latched, every animation sees the tick count read by LatchClock instead of reading
+	// the clock again. Latch once at the start of a frame so a UI full of animations reads the
+	// clock once and agrees on the time.
+	EQLIB_OBJECT static void LatchClock();
+	EQLIB_OBJECT static void UnlatchClock();
+	EQLIB_OBJECT static uint32_t GetClockTicks();
+
 	//----------------------------------------------------------------------------
 	// data members
 /*0x08*/ CXStr              Name;
 /*0x10*/ ArrayClass<STextureAnimationFrame> Frames;
 /*0x28*/ uint32_t           TotalTicks = 0;
 /*0x2c*/ int                ZeroFrame = 0;
-/*0x30*/ uint32_t           StartTicks = GetTickCount();
+/*0x30*/ uint32_t           StartTicks = GetClockTicks();
 /*0x34*/ CXSize             Size;
 /*0x3c*/ bool               bPaused = false;
 /*0x3d*/ bool               bCycle = true;
@@ -164,6 +178,31 @@ public:
 /*0x60*/
 };
 
+// The start times of a CTextureAnimation's frames, for finding the current frame of a long
+// animation with a binary search instead of walking its frames.
+//
+// The game owns the layout of CTextureAnimation, so the start times can't live in it. Keep the
+// timeline next to the animation it's used with, so it has the same lifetime. GetCurFrame
+// rebuilds it when the animation's frames change, and leaves short animations to
+// CTextureAnimation::GetCurFrame.
+class CTextureAnimationTimeline
+{
+public:
+	// Same result as anim.GetCurFrame().
+	EQLIB_OBJECT int GetCurFrame(const CTextureAnimation& anim);
+
+	EQLIB_OBJECT void Reset();
+
+private:
+	bool IsBuiltFrom(const CTextureAnimation& anim) const;
+	void Build(const CTextureAnimation& anim);
+
+	const STextureAnimationFrame* m_frames = nullptr;
+	int                           m_count = 0;
+	uint32_t                      m_totalTicks = 0;
+	std::vector<uint32_t>         m_startTicks;      // one per frame, plus the total at the end
+};
+
 //============================================================================
 // CTAFrameDraw
 //============================================================================
@@ -0,0 +1,391 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "pch.h"
+#include "WorldMessages.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace eqlib {
+
+static constexpr uint32_t WORLD_MESSAGE_FILE_MAGIC = 0x47534D57; // 'WMSG'
+static constexpr uint32_t WORLD_MESSAGE_FILE_VERSION = 1;
+
+struct WorldMessageFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+};
+
+struct WorldMessageRecordHeader
+{
+	uint32_t timestamp;
+	uint32_t opcode;
+	uint32_t length;
+};
+
+static FILE* OpenMessageFile(const std::string& path, const char* mode)
+{
+#if defined(_MSC_VER)
+	FILE* file = nullptr;
+	return fopen_s(&file, path.c_str(), mode) == 0 ? file : nullptr;
+#else
+	return fopen(path.c_str(), mode);
+#endif
+}
+
+static uint64_t GetRecorderTime()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//============================================================================
+// WorldMessageDispatcher
+//============================================================================
+
+WorldMessageDispatcher::WorldMessageDispatcher()
+	: m_opcodeSlots(std::make_unique<uint16_t[]>(FlatOpcodeCount))
+{
+}
+
+WorldMessageDispatcher::~WorldMessageDispatcher()
+{
+}
+
+WorldMessageDispatcher::HandlerList& WorldMessageDispatcher::GetOrCreateHandlers(uint32_t opcode)
+{
+	if (opcode == AnyOpcode)
+		return m_anyHandlers;
+
+	uint16_t* slot;
+	if (opcode < FlatOpcodeCount)
+		slot = &m_opcodeSlots[opcode];
+	else
+		slot = &m_largeOpcodeSlots[opcode];
+
+	if (*slot == 0)
+	{
+		m_handlerLists.emplace_back();
+		*slot = static_cast<uint16_t>(m_handlerLists.size());
+	}
+
+	return m_handlerLists[*slot - 1];
+}
+
+int WorldMessageDispatcher::AddHandler(uint32_t opcode, Handler handler)
+{
+	if (!handler)
+		return 0;
+
+	int id = m_nextHandlerId++;
+
+	if (m_dispatching)
+		m_pendingAdds.push_back(PendingHandler{ opcode, HandlerEntry{ id, std::move(handler) } });
+	else
+		GetOrCreateHandlers(opcode).push_back(HandlerEntry{ id, std::move(handler) });
+
+	return id;
+}
+
+bool WorldMessageDispatcher::RemoveHandler(int handlerId)
+{
+	auto removeFrom = [&](HandlerList& handlers)
+	{
+		auto iter = std::find_if(handlers.begin(), handlers.end(),
+			[handlerId](const HandlerEntry& entry) { return entry.id == handlerId; });
+		if (iter == handlers.end())
+			return false;
+
+		if (m_dispatching)
+		{
+			// The list is being walked, and the handler may be the one that is running. Mark it
+			// and remove it once the dispatch is done.
+			iter->id = 0;
+			m_needsCompact = true;
+		}
+		else
+		{
+			handlers.erase(iter);
+		}
+
+		return true;
+	};
+
+	auto pending = std::find_if(m_pendingAdds.begin(), m_pendingAdds.end(),
+		[handlerId](const PendingHandler& pending) { return pending.entry.id == handlerId; });
+	if (pending != m_pendingAdds.end())
+	{
+		m_pendingAdds.erase(pending);
+		return true;
+	}
+
+	if (removeFrom(m_anyHandlers))
+		return true;
+
+	for (HandlerList& handlers : m_handlerLists)
+	{
+		if (removeFrom(handlers))
+			return true;
+	}
+
+	return false;
+}
+
+void WorldMessageDispatcher::ClearHandlers()
+{
+	if (m_dispatching)
+	{
+		for (HandlerList& handlers : m_handlerLists)
+		{
+			for (HandlerEntry& entry : handlers)
+				entry.id = 0;
+		}
+
+		for (HandlerEntry& entry : m_anyHandlers)
+			entry.id = 0;
+
+		m_pendingAdds.clear();
+		m_needsCompact = true;
+		return;
+	}
+
+	std::fill(m_opcodeSlots.get(), m_opcodeSlots.get() + FlatOpcodeCount, uint16_t(0));
+	m_largeOpcodeSlots.clear();
+	m_handlerLists.clear();
+	m_anyHandlers.clear();
+}
+
+void WorldMessageDispatcher::ApplyPendingChanges()
+{
+	if (m_needsCompact)
+	{
+		auto isRemoved = [](const HandlerEntry& entry) { return entry.id == 0; };
+
+		for (HandlerList& handlers : m_handlerLists)
+			handlers.erase(std::remove_if(handlers.begin(), handlers.end(), isRemoved), handlers.end());
+
+		m_anyHandlers.erase(std::remove_if(m_anyHandlers.begin(), m_anyHandlers.end(), isRemoved), m_anyHandlers.end());
+		m_needsCompact = false;
+	}
+
+	for (PendingHandler& pending : m_pendingAdds)
+		GetOrCreateHandlers(pending.opcode).push_back(std::move(pending.entry));
+
+	m_pendingAdds.clear();
+}
+
+bool WorldMessageDispatcher::Dispatch(uint32_t opcode, const char* data, uint32_t length)
+{
+	++m_dispatched;
+
+	if (m_recorder)
+		m_recorder->Record(opcode, data, length);
+
+	const HandlerList* handlers = FindHandlers(opcode);
+	if (!handlers && m_anyHandlers.empty())
+		return false;
+
+	WorldMessage message{ opcode, data, length };
+	bool consumed = false;
+
+	++m_dispatching;
+
+	if (handlers)
+	{
+		for (const HandlerEntry& entry : *handlers)
+		{
+			if (entry.id != 0 && entry.handler(message))
+				consumed = true;
+		}
+	}
+
+	for (const HandlerEntry& entry : m_anyHandlers)
+	{
+		if (entry.id != 0 && entry.handler(message))
+			consumed = true;
+	}
+
+	if (--m_dispatching == 0 && (m_needsCompact || !m_pendingAdds.empty()))
+		ApplyPendingChanges();
+
+	return consumed;
+}
+
+//============================================================================
+// WorldMessageRecorder
+//============================================================================
+
+WorldMessageRecorder::WorldMessageRecorder(size_t bufferSize)
+{
+	m_capacity = 4096;
+	while (m_capacity < bufferSize)
+		m_capacity <<= 1;
+
+	m_ring = std::make_unique<uint8_t[]>(m_capacity);
+}
+
+WorldMessageRecorder::~WorldMessageRecorder()
+{
+	Stop();
+}
+
+bool WorldMessageRecorder::Start(const std::string& path)
+{
+	Stop();
+
+	FILE* file = OpenMessageFile(path, "wb");
+	if (!file)
+		return false;
+
+	WorldMessageFileHeader header{ WORLD_MESSAGE_FILE_MAGIC, WORLD_MESSAGE_FILE_VERSION };
+	if (fwrite(&header, sizeof(header), 1, file) != 1)
+	{
+		fclose(file);
+		return false;
+	}
+
+	m_file = file;
+	m_writePos = 0;
+	m_readPos = 0;
+	m_recorded = 0;
+	m_dropped = 0;
+	m_startTime = GetRecorderTime();
+
+	m_running = true;
+	m_writer = std::thread([this]() { WriterThread(); });
+	return true;
+}
+
+void WorldMessageRecorder::Stop()
+{
+	if (!m_file)
+		return;
+
+	m_running = false;
+	if (m_writer.joinable())
+		m_writer.join();
+
+	Drain();
+
+	fclose(m_file);
+	m_file = nullptr;
+}
+
+bool WorldMessageRecorder::Record(uint32_t opcode, const char* data, uint32_t length)
+{
+	if (!m_file)
+		return false;
+
+	WorldMessageRecordHeader header{ static_cast<uint32_t>(GetRecorderTime() - m_startTime), opcode, length };
+	size_t needed = sizeof(header) + length;
+
+	size_t writePos = m_writePos.load(std::memory_order_relaxed);
+	size_t readPos = m_readPos.load(std::memory_order_acquire);
+
+	if (needed > m_capacity - (writePos - readPos))
+	{
+		++m_dropped;
+		return false;
+	}
+
+	auto copyIn = [this](size_t pos, const void* source, size_t size)
+	{
+		size_t offset = pos & (m_capacity - 1);
+		size_t first = std::min(size, m_capacity - offset);
+
+		memcpy(&m_ring[offset], source, first);
+		memcpy(&m_ring[0], static_cast<const uint8_t*>(source) + first, size - first);
+	};
+
+	copyIn(writePos, &header, sizeof(header));
+	copyIn(writePos + sizeof(header), data, length);
+
+	// Publish the message to the writer only once all of it is in the ring.
+	m_writePos.store(writePos + needed, std::memory_order_release);
+	++m_recorded;
+	return true;
+}
+
+void WorldMessageRecorder::Drain()
+{
+	size_t readPos = m_readPos.load(std::memory_order_relaxed);
+	size_t writePos = m_writePos.load(std::memory_order_acquire);
+
+	if (readPos == writePos)
+		return;
+
+	while (readPos != writePos)
+	{
+		size_t offset = readPos & (m_capacity - 1);
+		size_t chunk = std::min(writePos - readPos, m_capacity - offset);
+
+		fwrite(&m_ring[offset], 1, chunk, m_file);
+		readPos += chunk;
+	}
+
+	// Hand the space back to the producer.
+	m_readPos.store(readPos, std::memory_order_release);
+	fflush(m_file);
+}
+
+void WorldMessageRecorder::WriterThread()
+{
+	while (m_running.load(std::memory_order_relaxed))
+	{
+		Drain();
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
+//============================================================================
+
+int ReplayWorldMessages(const std::string& path, WorldMessageDispatcher& dispatcher)
+{
+	FILE* file = OpenMessageFile(path, "rb");
+	if (!file)
+		return -1;
+
+	WorldMessageFileHeader header;
+	if (fread(&header, sizeof(header), 1, file) != 1
+		|| header.magic != WORLD_MESSAGE_FILE_MAGIC
+		|| header.version != WORLD_MESSAGE_FILE_VERSION)
+	{
+		fclose(file);
+		return -1;
+	}
+
+	std::vector<char> payload;
+	int numMessages = 0;
+
+	WorldMessageRecordHeader record;
+	while (fread(&record, sizeof(record), 1, file) == 1)
+	{
+		payload.resize(record.length);
+
+		// A record cut short by a crash ends the replay.
+		if (record.length != 0 && fread(payload.data(), record.length, 1, file) != 1)
+			break;
+
+		dispatcher.Dispatch(record.opcode, payload.data(), record.length);
+		++numMessages;
+	}
+
+	fclose(file);
+	return numMessages;
+}
+
+} // namespace eqlib
@@ -0,0 +1,195 @@
+/*
+ * MacroQuest: The extension platform for EverQuest
+ * Copyright (C) 2002-present MacroQuest Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2, as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "Config.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace eqlib {
+
+// A world message as it was handed to CEverQuest::HandleWorldMessage. The payload belongs to
+// the caller and is only valid during the dispatch.
+struct WorldMessage
+{
+	uint32_t    opcode;
+	const char* data;
+	uint32_t    length;
+
+	const char* begin() const { return data; }
+	const char* end() const { return data + length; }
+	bool empty() const { return length == 0; }
+};
+
+class WorldMessageRecorder;
+
+//============================================================================
+// WorldMessageDispatcher
+//============================================================================
+
+// Routes world messages to handlers registered for their opcode.
+//
+// Handlers for a given opcode are found with a single lookup in a flat table indexed by opcode,
+// so a message nobody listens for costs one load, and handlers don't have to switch on the
+// opcode themselves. Handlers registered for all opcodes run after the opcode's own handlers.
+//
+// Whoever detours CEverQuest::HandleWorldMessage calls Dispatch with the message before (or
+// instead of) passing it on to the game.
+class WorldMessageDispatcher
+{
+public:
+	// Return true to consume the message, i.e. to ask that it not be passed on to the game.
+	// Every handler is called regardless.
+	using Handler = std::function<bool(const WorldMessage& message)>;
+
+	static constexpr uint32_t AnyOpcode = 0xffffffff;
+
+	EQLIB_OBJECT WorldMessageDispatcher();
+	EQLIB_OBJECT ~WorldMessageDispatcher();
+
+	// Registers |handler| for |opcode| (or AnyOpcode). Returns an id for RemoveHandler. Handlers
+	// may add and remove handlers, the changes take effect after the current dispatch.
+	EQLIB_OBJECT int AddHandler(uint32_t opcode, Handler handler);
+	EQLIB_OBJECT bool RemoveHandler(int handlerId);
+	EQLIB_OBJECT void ClearHandlers();
+
+	// Messages are copied to |recorder| before they are handled. Pass nullptr to stop. The
+	// dispatcher does not take ownership.
+	void SetRecorder(WorldMessageRecorder* recorder) { m_recorder = recorder; }
+
+	// Hands the message to its handlers. Returns true if any of them consumed it.
+	EQLIB_OBJECT bool Dispatch(uint32_t opcode, const char* data, uint32_t length);
+
+	bool HasHandlers(uint32_t opcode) const { return FindHandlers(opcode) != nullptr || !m_anyHandlers.empty(); }
+
+	uint64_t GetDispatchCount() const { return m_dispatched; }
+
+private:
+	struct HandlerEntry
+	{
+		int id;
+		Handler handler;
+	};
+	using HandlerList = std::vector<HandlerEntry>;
+
+	// Opcodes are 16 bits, so they index a flat table directly. Anything larger is looked up.
+	static constexpr uint32_t FlatOpcodeCount = 0x10000;
+
+	const HandlerList* FindHandlers(uint32_t opcode) const
+	{
+		if (opcode < FlatOpcodeCount)
+		{
+			uint16_t slot = m_opcodeSlots[opcode];
+			return slot != 0 ? &m_handlerLists[slot - 1] : nullptr;
+		}
+
+		auto iter = m_largeOpcodeSlots.find(opcode);
+		return iter != m_largeOpcodeSlots.end() ? &m_handlerLists[iter->second - 1] : nullptr;
+	}
+
+	HandlerList& GetOrCreateHandlers(uint32_t opcode);
+	void ApplyPendingChanges();
+
+	std::unique_ptr<uint16_t[]> m_opcodeSlots;                 // opcode -> 1 + index into m_handlerLists
+	std::unordered_map<uint32_t, uint16_t> m_largeOpcodeSlots;
+	std::vector<HandlerList> m_handlerLists;
+	HandlerList m_anyHandlers;
+
+	// Handlers can be added and removed by handlers. The lists being walked are left alone until
+	// the dispatch is done.
+	struct PendingHandler
+	{
+		uint32_t opcode;
+		HandlerEntry entry;
+	};
+	std::vector<PendingHandler> m_pendingAdds;
+	int m_dispatching = 0;
+	bool m_needsCompact = false;
+
+	WorldMessageRecorder* m_recorder = nullptr;
+	int m_nextHandlerId = 1;
+	uint64_t m_dispatched = 0;
+};
+
+//============================================================================
+// WorldMessageRecorder
+//============================================================================
+
+// Writes world messages to a file, for replaying later with ReplayWorldMessages.
+//
+// Record is called on the game thread and only copies the message into a ring buffer; a
+// background thread drains the buffer to disk. The two sides share nothing but the ring's read
+// and write positions, so recording never waits on the disk. If the ring is full the message is
+// dropped and counted.
+//
+// The file is a small header followed by one record per message: the time since recording
+// started in milliseconds, the opcode and the payload length (all 32 bit, little endian), then
+// the payload.
+class WorldMessageRecorder
+{
+public:
+	// |bufferSize| is rounded up to a power of two.
+	EQLIB_OBJECT WorldMessageRecorder(size_t bufferSize = 4 * 1024 * 1024);
+	EQLIB_OBJECT ~WorldMessageRecorder();
+
+	WorldMessageRecorder(const WorldMessageRecorder&) = delete;
+	WorldMessageRecorder& operator=(const WorldMessageRecorder&) = delete;
+
+	EQLIB_OBJECT bool Start(const std::string& path);
+
+	// Writes out everything that was recorded and closes the file.
+	EQLIB_OBJECT void Stop();
+
+	bool IsRecording() const { return m_file != nullptr; }
+
+	// Called by the producer (game) thread only.
+	EQLIB_OBJECT bool Record(uint32_t opcode, const char* data, uint32_t length);
+
+	uint64_t GetRecordedCount() const { return m_recorded; }
+	uint64_t GetDroppedCount() const { return m_dropped; }
+
+private:
+	void WriterThread();
+	void Drain();
+
+	std::unique_ptr<uint8_t[]> m_ring;
+	size_t m_capacity;
+
+	// Byte counts written into and read out of the ring since Start, only ever increasing.
+	std::atomic<size_t> m_writePos{ 0 };
+	std::atomic<size_t> m_readPos{ 0 };
+
+	FILE* m_file = nullptr;
+	std::thread m_writer;
+	std::atomic<bool> m_running{ false };
+	uint64_t m_startTime = 0;
+
+	uint64_t m_recorded = 0;
+	uint64_t m_dropped = 0;
+};
+
+// Reads a file written by WorldMessageRecorder and dispatches every message in it, in order.
+// Returns the number of messages dispatched, or -1 if the file can't be read.
+EQLIB_OBJECT int ReplayWorldMessages(const std::string& path, WorldMessageDispatcher& dispatcher);
+
+} // namespace eqlib